@@ -7,10 +7,28 @@
 
 #include "rvl_p.h"
 
-void rvl_compress_lzma (RVL *self, BYTE **out, u32 *size);
-void rvl_decompress_lzma (RVL *self, const BYTE *in, u32 size);
+/**
+ * Compress data.wbuf block by block into data.blocks
+ *
+ * The block index must have been allocated. Blocks are compressed in parallel
+ * when librvl is built with OpenMP.
+ */
+void rvl_compress_blocks (RVL *self);
 
-void rvl_compress_lz4 (RVL *self, BYTE **out, u32 *size);
-void rvl_decompress_lz4 (RVL *self, const BYTE *in, u32 size);
+/**
+ * Decompress the payloads of data.blocks into data.rbuf and free them
+ *
+ * Blocks are decompressed in parallel when librvl is built with OpenMP.
+ */
+void rvl_decompress_blocks (RVL *self);
+
+/**
+ * Decompress a single block of outSize bytes
+ *
+ * Safe to call from any thread. Returns 0 on success, or an lzma_ret for
+ * LZMA2 and -1 otherwise.
+ */
+int rvl_decompress_block (RVLCompress method, const BYTE *in, u32 size,
+                          BYTE *out, u32 outSize);
 
 #endif
@@ -0,0 +1,25 @@
+#ifndef RVL_MAP_P_H
+#define RVL_MAP_P_H
+
+#ifndef RVL_H_INTERNAL
+#error Never include this file directly. Use <rvl.h> instead.
+#endif
+
+#include <stdbool.h>
+
+#include "detail/rvl_p.h"
+
+/**
+ * Map size bytes of the file stream at offset read-only into memory
+ *
+ * The offset does not need to be aligned. On success, data.mbuf points at the
+ * mapped bytes until rvl_unmap_file is called.
+ */
+bool rvl_map_file (RVL *self, u64 offset, u64 size);
+void rvl_unmap_file (RVL *self);
+
+// Position of the file stream, which may be beyond 2 GiB
+u64  rvl_ftell (RVL *self);
+void rvl_fseek (RVL *self, u64 offset);
+
+#endif
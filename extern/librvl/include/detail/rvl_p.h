@@ -5,6 +5,7 @@
 #error Never include this file directly. Use <rvl.h> instead.
 #endif
 
+#include <setjmp.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -13,6 +14,7 @@
 
 typedef uint8_t  BYTE;
 typedef uint32_t u32;
+typedef uint64_t u64;
 typedef float    f32;
 typedef uint8_t  u8;
 typedef uint16_t u16;
@@ -31,13 +33,62 @@ typedef struct RVLText RVLText;
 typedef void (*RVLWriteFn) (RVL *, const BYTE *, u32);
 typedef void (*RVLReadFn) (RVL *, BYTE *, u32);
 
+typedef struct
+{
+  u32   size;   // Compressed size
+  u64   offset; // Position of the payload in the file, only for reading
+  BYTE *buf;    // Compressed payload, only held during reading or writing
+} RVLBlock;
+
+/**
+ * Decoded blocks kept by rvl_read_region
+ *
+ * The entries are few, so the least recently used one is found by a linear
+ * search.
+ */
+typedef struct
+{
+  u32   block;
+  u64   lastUse;
+  BYTE *buf; // NULL if the entry is unused
+} RVLCacheEntry;
+
+typedef struct
+{
+  RVLCacheEntry *entries;
+  u32            capacity;
+  u64            clock;
+} RVLBlockCache;
+
 typedef struct
 {
   const BYTE *wbuf; // Non-owning pointer
   BYTE       *rbuf;
-  u32         size;
+  bool        rbufBorrowed; // rbuf is the buffer of rvl_read_voxels_to
+  const BYTE *mbuf; // Pointer into the file mapping, used instead of rbuf
+  u64         size;
+
+  /**
+   * Block index
+   *
+   * The voxels are split into blocks of blockSize bytes, the last one may be
+   * shorter, and each block is compressed independently.
+   */
+  u32       blockSize;
+  u32       nblocks;
+  u32       nread; // Number of DATA chunks read so far
+  RVLBlock *blocks;
 } RVLData;
 
+typedef struct
+{
+  void *addr; // Start of the mapped view
+  u64   size;
+#ifdef _WIN32
+  void *handle;
+#endif
+} RVLMapping;
+
 typedef struct
 {
   RVLGridType type;
@@ -74,6 +125,14 @@ typedef uint32_t RVLChunkCode;
 #define RVL_CHUNK_CODE_DATA CHUNK_CODE (68, 65, 84, 65)
 #define RVL_CHUNK_CODE_TEXT CHUNK_CODE (84, 69, 88, 84)
 #define RVL_CHUNK_CODE_VEND CHUNK_CODE (86, 69, 78, 68)
+#define RVL_CHUNK_CODE_BIDX CHUNK_CODE (66, 73, 68, 88)
+
+// Uncompressed bytes per block unless set with rvl_set_block_size
+#define RVL_DEFAULT_BLOCK_SIZE (1U << 24)
+#define RVL_MAX_BLOCK_SIZE     (1U << 30)
+
+// Decoded blocks kept by rvl_read_region unless set otherwise
+#define RVL_DEFAULT_BLOCK_CACHE_SIZE 4
 
 // RVL File Signature: .RVL FORMAT\0
 #define RVL_FILE_SIG_SIZE 12
@@ -105,18 +164,56 @@ struct RVL
   RVLGrid grid;
 
   /* DATA chunk */
-  RVLData data;
+  RVLData       data;
+  RVLMapping    mapping;
+  RVLBlockCache cache;
 
   /* TEXT chunk */
   RVLText *text;
+
+  // Payload of the chunk being read, kept by the instance so that nothing
+  // leaks when reading fails
+  BYTE *chunkBuf;
+  u32   chunkBufSz;
+
+  /* Error recovery */
+  jmp_buf errorJmp;
+  bool    hasErrorJmp;
+  char    error[256];
 };
 
-void rvl_alloc (RVL *self, BYTE **ptr, u32 size);
+#if defined(__GNUC__) || defined(__clang__)
+#  define RVL_NORETURN __attribute__ ((noreturn))
+#else
+#  define RVL_NORETURN
+#endif
+
+/**
+ * Log a fatal error and jump to the buffer of rvl_error_jmpbuf
+ *
+ * Without a buffer, the process exits as before. Must not be called from
+ * the threads of a parallel region.
+ */
+RVL_NORETURN void rvl_fail_at (RVL *self, const char *funcName,
+                               const char *fmt, ...);
+#define rvl_fail(self, ...) rvl_fail_at (self, __func__, __VA_ARGS__)
+
+void rvl_alloc (RVL *self, BYTE **ptr, u64 size);
+
+// Buffer of at least size bytes for a chunk payload, valid until the next
+// call
+BYTE *rvl_chunk_buffer (RVL *self, u32 size);
 void rvl_dealloc (RVL *self, BYTE **ptr);
 void rvl_fwrite_default (RVL *self, const BYTE *data, u32 size);
 void rvl_fread_default (RVL *self, BYTE *data, u32 size);
 
-unsigned int rvl_eval_voxels_nbytes (RVL *self);
+u64 rvl_eval_voxels_nbytes (RVL *self);
+
+void rvl_alloc_blocks (RVL *self, u32 blockSize, u32 nblocks);
+void rvl_dealloc_blocks (RVL *self);
+
+// Uncompressed size of a block, which is shorter for the last one
+u32 rvl_block_nbytes (RVL *self, u32 index);
 
 void rvl_calculate_crc32 (RVL *self, const BYTE *buf, u32 size);
 void rvl_reset_crc32 (RVL *self);
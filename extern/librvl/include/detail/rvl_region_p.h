@@ -0,0 +1,26 @@
+#ifndef RVL_REGION_P_H
+#define RVL_REGION_P_H
+
+#ifndef RVL_H_INTERNAL
+#error Never include this file directly. Use <rvl.h> instead.
+#endif
+
+#include "detail/rvl_p.h"
+
+/**
+ * Locate the DATA chunks of the file without reading them
+ *
+ * Reads the chunks up to the first DATA chunk and fills the block index,
+ * including the position of every block. The file stream is rewound to the
+ * first chunk afterwards.
+ */
+void rvl_read_block_index (RVL *self);
+
+/**
+ * Read, check and decompress a single block into out
+ */
+void rvl_read_block (RVL *self, u32 index, BYTE *out);
+
+void rvl_clear_block_cache (RVL *self);
+
+#endif
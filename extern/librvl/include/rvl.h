@@ -15,9 +15,9 @@
        +08 NB chunk payload
        +xx 4B CRC32
 
-   There are 5 types of chunk: VFMT, GRID, DATA, TEXT, VEND. A valid RVL file
-   must contain a VFMT chunk, a GRID chunk, one or more DATA chunks, and a VEND
-   chunk.
+   There are 6 types of chunk: VFMT, GRID, BIDX, DATA, TEXT, VEND. A valid RVL
+   file must contain a VFMT chunk, a GRID chunk, a BIDX chunk, one or more DATA
+   chunks, and a VEND chunk.
 
    VFMT Chunk
    ++++++++++
@@ -57,6 +57,32 @@
        +xx [voxel dimensions in z-direction]
 
 
+   BIDX Chunk
+   ++++++++++
+
+       +00  8B   size of the voxel data in bytes
+       +08  4B   block size (B bytes)
+       +12  4B   number of blocks (N)
+       +16 4NB   compressed size of each block
+
+   The voxel data is split into blocks of B bytes, the last one may be shorter.
+   Each block is compressed independently and stored in its own DATA chunk, in
+   the order of the index, so the blocks can be decompressed in parallel and
+   the voxel data is not limited by the 4 GiB size of a chunk.
+
+
+   DATA Chunk
+   ++++++++++
+
+       +00  nB   compressed block
+
+   Without compression, the voxel data is stored as a single block whenever it
+   fits into one chunk, so that it can be mapped into memory as it is.
+
+   Files of v0.7 have no BIDX chunk, and their voxel data is a single DATA
+   chunk. They can still be read.
+
+
    TEXT Chunk
    ++++++++++
 
@@ -88,10 +114,11 @@
 #ifndef RVL_H
 #define RVL_H
 
+#include <setjmp.h>
 #include <stdio.h>
 
 #define RVL_VERSION_MAJOR 0
-#define RVL_VERSION_MINOR 7
+#define RVL_VERSION_MINOR 8
 
 /* RVL struct types */
 typedef struct RVL RVL;
@@ -177,6 +204,7 @@ typedef unsigned int RVLenum;
 
 #define RVL_COMPRESSION_LZMA2 0x00
 #define RVL_COMPRESSION_LZ4   0x01
+#define RVL_COMPRESSION_NONE  0x02
 
 #define RVL_TEXT_TITLE         0x0D01
 #define RVL_TEXT_DESCRIPTION   0x0D02
@@ -216,6 +244,21 @@ RVLLIB_API RVL *rvl_create_writer (void);
 RVLLIB_API RVL *rvl_create_reader (void);
 RVLLIB_API void rvl_destroy (RVL **self);
 
+// Recover from errors instead of exiting. A failing call jumps back to the
+// setjmp on the returned buffer, and rvl_get_error tells what went wrong:
+//
+//   if (setjmp (*rvl_error_jmpbuf (rvl)) != 0)
+//     {
+//       fprintf (stderr, "%s\n", rvl_get_error (rvl));
+//       return;
+//     }
+//
+// The buffer is only valid until the function that called setjmp returns, so
+// every function that calls librvl has to call setjmp again. After an error,
+// the instance can still be given another file or be destroyed.
+RVLLIB_API jmp_buf    *rvl_error_jmpbuf (RVL *self);
+RVLLIB_API const char *rvl_get_error (RVL *self);
+
 RVLLIB_API void rvl_set_file (RVL *self, const char *filename);
 RVLLIB_API void rvl_set_io (RVL *self, FILE *stream);
 
@@ -233,6 +276,25 @@ RVLLIB_API void rvl_read_info (RVL *self);
 // deallocation is managed by the user.
 RVLLIB_API void rvl_read_voxels_to (RVL *self, void *buffer);
 
+// Map the uncompressed voxel data read-only into memory instead of reading it.
+// Call after rvl_read_info. The pointer is also returned by rvl_get_voxels and
+// stays valid until the file is changed or the instance is destroyed. The CRC
+// of the voxel data is not checked. Returns NULL if the data is compressed or
+// split into several blocks, or if mapping failed.
+RVLLIB_API const void *rvl_map_voxels (RVL *self);
+
+// Read the voxels of the box from (x0, y0, z0) with the size (nx, ny, nz) into
+// the buffer, ordered by x, then y, then z. The buffer must hold
+// nx * ny * nz voxels. Only the blocks of voxel data that overlap the box are
+// decompressed, and the most recently used ones are kept for later calls. If
+// the whole volume has been read or mapped, the voxels are copied from there.
+RVLLIB_API void rvl_read_region (RVL *self, int x0, int y0, int z0, int nx,
+                                 int ny, int nz, void *buffer);
+
+// Set the number of decompressed blocks kept by rvl_read_region. The default
+// is 4. Setting it drops the blocks kept so far.
+RVLLIB_API void rvl_set_block_cache_size (RVL *self, unsigned int count);
+
 /* VFMT chunk functions */
 RVLLIB_API void rvl_set_volumetric_format (RVL *self, int nx, int ny, int nz,
                                            RVLenum primitive, RVLenum endian);
@@ -242,6 +304,11 @@ RVLLIB_API void rvl_get_volumetric_format (RVL *self, int *nx, int *ny, int *nz,
 RVLLIB_API void    rvl_set_compression (RVL *self, RVLenum compression);
 RVLLIB_API RVLenum rvl_get_compression (RVL *self);
 
+// Set the number of uncompressed bytes per block of voxel data. Smaller blocks
+// decompress on more threads at a slightly worse compression ratio. The
+// default is 16 MiB.
+RVLLIB_API void rvl_set_block_size (RVL *self, unsigned int size);
+
 // Get the byte size of the primitive type.
 RVLLIB_API unsigned int rvl_sizeof (RVLenum primitive);
 
@@ -276,6 +343,10 @@ RVLLIB_API void* rvl_get_voxels (RVL *self);
 // Get the pointer to the voxel by x, y, and z indices.
 RVLLIB_API void* rvl_get_voxel_at (RVL *self, int x, int y, int z);
 
+// Get the byte size of the primitive type and of the whole voxel data.
+RVLLIB_API unsigned int       rvl_get_primitive_nbytes (RVL *self);
+RVLLIB_API unsigned long long rvl_get_data_nbytes (RVL *self);
+
 /* TEXT chunk functions */
 RVLLIB_API void rvl_set_text (RVL *self, RVLenum tag, const char *value);
 RVLLIB_API const char* rvl_get_text_value (RVL *self, RVLenum tag);
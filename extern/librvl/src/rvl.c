@@ -1,12 +1,15 @@
 #include <assert.h>
 #include <lzma.h>
+#include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "rvl.h"
 
 #include "detail/rvl_log_p.h"
+#include "detail/rvl_map_p.h"
 #include "detail/rvl_p.h"
+#include "detail/rvl_region_p.h"
 #include "detail/rvl_text_p.h"
 
 // .RVL FORMAT\0
@@ -42,8 +45,15 @@ rvl_destroy (RVL **self)
 
   // Dealloc read buffer. Writer buffer pointer is non-owning so the user is
   // responsible for calling this dealloc function.
-  rvl_dealloc (ptr, &ptr->data.rbuf);
+  if (!ptr->data.rbufBorrowed)
+    {
+      rvl_dealloc (ptr, &ptr->data.rbuf);
+    }
+  rvl_dealloc (ptr, &ptr->chunkBuf);
   rvl_dealloc (ptr, &ptr->grid.dimBuf);
+  rvl_dealloc_blocks (ptr);
+  rvl_unmap_file (ptr);
+  rvl_clear_block_cache (ptr);
 
   if (ptr->text != NULL)
     {
@@ -67,8 +77,40 @@ rvl_destroy (RVL **self)
   *self = NULL;
 }
 
+jmp_buf *
+rvl_error_jmpbuf (RVL *self)
+{
+  self->hasErrorJmp = true;
+  return &self->errorJmp;
+}
+
 void
-rvl_alloc (RVL *self, BYTE **ptr, u32 size)
+rvl_fail_at (RVL *self, const char *funcName, const char *fmt, ...)
+{
+  va_list args;
+  va_start (args, fmt);
+  vsnprintf (self->error, sizeof (self->error), fmt, args);
+  va_end (args);
+
+  rvl_log (RVL_LOG_LEVEL_FATAL, funcName, "%s", self->error);
+
+  if (!self->hasErrorJmp)
+    {
+      exit (EXIT_FAILURE);
+    }
+
+  // The buffer of rvl_read_voxels_to belongs to the caller.
+  if (self->data.rbufBorrowed)
+    {
+      self->data.rbuf         = NULL;
+      self->data.rbufBorrowed = false;
+    }
+
+  longjmp (self->errorJmp, 1);
+}
+
+void
+rvl_alloc (RVL *self, BYTE **ptr, u64 size)
 {
   assert (self != NULL || ptr != NULL);
 
@@ -77,12 +119,11 @@ rvl_alloc (RVL *self, BYTE **ptr, u32 size)
       free (*ptr);
     }
 
-  *ptr = (BYTE *)calloc (1, size);
+  *ptr = (BYTE *)calloc (1, (size_t)size);
 
   if (*ptr == NULL)
     {
-      rvl_log_fatal ("Memory allocation failure.");
-      exit (EXIT_FAILURE);
+      rvl_fail (self, "Memory allocation failure.");
     }
 }
 
@@ -98,6 +139,58 @@ rvl_dealloc (RVL *self, BYTE **ptr)
   *ptr = NULL;
 }
 
+BYTE *
+rvl_chunk_buffer (RVL *self, u32 size)
+{
+  if (size > self->chunkBufSz || self->chunkBuf == NULL)
+    {
+      rvl_alloc (self, &self->chunkBuf, size > 0 ? size : 1);
+      self->chunkBufSz = size;
+    }
+
+  return self->chunkBuf;
+}
+
+void
+rvl_alloc_blocks (RVL *self, u32 blockSize, u32 nblocks)
+{
+  rvl_dealloc_blocks (self);
+
+  self->data.blockSize = blockSize;
+  self->data.nblocks   = nblocks;
+  self->data.nread     = 0;
+  self->data.blocks    = (RVLBlock *)calloc (nblocks, sizeof (RVLBlock));
+
+  if (self->data.blocks == NULL)
+    {
+      rvl_fail (self, "Memory allocation failure.");
+    }
+}
+
+void
+rvl_dealloc_blocks (RVL *self)
+{
+  if (self->data.blocks == NULL)
+    return;
+
+  for (u32 i = 0; i < self->data.nblocks; i++)
+    {
+      free (self->data.blocks[i].buf);
+    }
+
+  free (self->data.blocks);
+  self->data.blocks  = NULL;
+  self->data.nblocks = 0;
+  self->data.nread   = 0;
+}
+
+u32
+rvl_block_nbytes (RVL *self, u32 index)
+{
+  const u64 remain = self->data.size - (u64)index * self->data.blockSize;
+  return remain < self->data.blockSize ? (u32)remain : self->data.blockSize;
+}
+
 RVL *
 rvl_create (RVLIoState ioState)
 {
@@ -111,6 +204,8 @@ rvl_create (RVLIoState ioState)
 
   // Explicitly set the default values of the optional settings.
   self->compress         = RVL_COMPRESSION_LZMA2;
+  self->data.blockSize   = RVL_DEFAULT_BLOCK_SIZE;
+  self->cache.capacity   = RVL_DEFAULT_BLOCK_CACHE_SIZE;
   self->grid.unit        = RVL_UNIT_NA;
   self->grid.position[0] = 0.0f;
   self->grid.position[1] = 0.0f;
@@ -149,7 +244,7 @@ rvl_sizeof (RVLenum primitive)
   return nbytes;
 }
 
-unsigned int
+u64
 rvl_eval_voxels_nbytes (RVL *self)
 {
   const u32 *res = self->resolution;
@@ -159,7 +254,7 @@ rvl_eval_voxels_nbytes (RVL *self)
       rvl_log_error ("Invalid resolution: %d, %d, %d", res[0], res[1], res[2]);
     }
 
-  return res[0] * res[1] * res[2] * rvl_sizeof (self->primitive);
+  return (u64)res[0] * res[1] * res[2] * rvl_sizeof (self->primitive);
 }
 
 void
@@ -1,5 +1,7 @@
+#include <inttypes.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <lz4.h>
 #include <lz4hc.h>
@@ -13,128 +15,203 @@ lzma_filter *get_lzma_default_filters ();
 static void print_lzma_compression_error (lzma_ret ret);
 static void print_lzma_decompression_error (lzma_ret ret);
 
+static int rvl_compress_block (RVLCompress method, const BYTE *src,
+                               u32 srcSize, RVLBlock *block);
+
+/*
+ * The block functions run on worker threads and the logger is not
+ * thread-safe, so they report errors as codes and the callers log them once
+ * all blocks are done. The codes are lzma_ret values for LZMA2 and -1 for
+ * LZ4.
+ */
+
 void
-rvl_compress_lzma (RVL *self, BYTE **out, u32 *size)
+rvl_compress_blocks (RVL *self)
 {
-  const BYTE *src     = self->data.wbuf;
-  u32         srcSize = self->data.size;
-  u32         dstCap  = self->data.size;
-
-  rvl_log_debug ("Starting XZ compression. The original size is %u bytes.",
-                 srcSize);
+  const RVLData *data   = &self->data;
+  const int      count  = (int)data->nblocks;
+  int            failed = -1;
+  int            error  = 0;
 
-  lzma_filter *filters = get_lzma_default_filters ();
+  rvl_log_debug ("Starting compression of %u blocks. The original size is "
+                 "%" PRIu64 " bytes.",
+                 data->nblocks, data->size);
 
-  lzma_ret ret;
-  size_t   outPos = 0;
-  ret = lzma_raw_buffer_encode (filters, NULL, src, srcSize, *out, &outPos,
-                                dstCap);
+  // Initialize the static filter options before the threads read them.
+  get_lzma_default_filters ();
 
-  // Handle tiny data
-  if (ret == LZMA_BUF_ERROR)
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < count; i++)
     {
-      dstCap = 256;
-      *out   = realloc (*out, dstCap);
-
-      rvl_log_debug ("Reallocate output memory to %u bytes.", dstCap);
-      ret = lzma_raw_buffer_encode (filters, NULL, src, srcSize, *out, &outPos,
-                                    dstCap);
+      const u64 offset = (u64)i * data->blockSize;
+      const u32 size   = rvl_block_nbytes (self, i);
+
+      int ret = rvl_compress_block (self->compress, data->wbuf + offset, size,
+                                    &data->blocks[i]);
+      if (ret != 0)
+        {
+#pragma omp critical
+          {
+            failed = i;
+            error  = ret;
+          }
+        }
     }
 
-  if (ret != LZMA_OK)
+  if (failed >= 0)
     {
-      print_lzma_compression_error (ret);
-      exit (EXIT_FAILURE);
+      if (self->compress == RVL_COMPRESSION_LZMA2)
+        {
+          print_lzma_compression_error ((lzma_ret)error);
+        }
+      rvl_fail (self, "Compression of block %d failed.", failed);
     }
-
-  *size = outPos;
-  rvl_log_debug ("Compression succeeded. The result has %u bytes.", outPos);
 }
 
 void
-rvl_decompress_lzma (RVL *self, const BYTE *in, u32 size)
+rvl_decompress_blocks (RVL *self)
 {
-  BYTE *out    = self->data.rbuf;
-  u32   dstCap = self->data.size;
-
-  lzma_filter *filters = get_lzma_default_filters ();
+  const RVLData *data   = &self->data;
+  const int      count  = (int)data->nblocks;
+  int            failed = -1;
+  int            error  = 0;
 
-  lzma_ret ret;
-  size_t   inPos  = 0;
-  size_t   outPos = 0;
-  ret = lzma_raw_buffer_decode (filters, NULL, in, &inPos, size, out, &outPos,
-                                dstCap);
+  get_lzma_default_filters ();
 
-  if (ret != LZMA_OK)
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < count; i++)
     {
-      print_lzma_decompression_error (ret);
-      exit (EXIT_FAILURE);
+      const u64 offset = (u64)i * data->blockSize;
+      const u32 size   = rvl_block_nbytes (self, i);
+
+      RVLBlock *block = &data->blocks[i];
+      int ret = rvl_decompress_block (self->compress, block->buf, block->size,
+                                      data->rbuf + offset, size);
+      free (block->buf);
+      block->buf = NULL;
+
+      if (ret != 0)
+        {
+#pragma omp critical
+          {
+            failed = i;
+            error  = ret;
+          }
+        }
     }
 
-  if (outPos != self->data.size)
+  if (failed >= 0)
     {
-      rvl_log_fatal ("Decompression failed. The original data size should be "
-                     "%u. However, the decompressed size was %u.",
-                     self->data.size, outPos);
-      exit (EXIT_FAILURE);
+      if (self->compress == RVL_COMPRESSION_LZMA2)
+        {
+          print_lzma_decompression_error ((lzma_ret)error);
+        }
+      rvl_fail (self, "Decompression of block %d failed. Possibly file "
+                      "corruption.",
+                      failed);
     }
 
-  rvl_log_debug ("Decompression succeeded. The result has %u bytes.", outPos);
+  rvl_log_debug ("Decompression succeeded. The result has %" PRIu64 " bytes.",
+                 data->size);
 }
 
-void
-rvl_compress_lz4 (RVL *self, BYTE **out, u32 *size)
+int
+rvl_compress_block (RVLCompress method, const BYTE *src, u32 srcSize,
+                    RVLBlock *block)
 {
-  const char *src     = (const char *)self->data.wbuf;
-  u32         srcSize = self->data.size;
-  char       *dst     = (char *)*out;
-  u32         dstCap  = self->data.size;
-
-  rvl_log_debug ("Starting LZ4 compression. The original size is %u bytes.",
-                 srcSize);
-
-  int nbytes = LZ4_compress_HC (src, dst, srcSize, dstCap, LZ4HC_CLEVEL_MIN);
+  block->buf  = NULL;
+  block->size = 0;
 
-  // When the compressed size is greater than the uncompressed one.
-  if (nbytes == 0)
+  // Stored blocks are written straight from the voxel data.
+  if (method == RVL_COMPRESSION_NONE)
     {
-      dstCap = LZ4_compressBound (self->data.size);
-
-      rvl_log_debug ("Reallocate output memory to %u bytes.", dstCap);
-
-      *out   = realloc (*out, dstCap);
-      dst    = (char *)*out;
-      nbytes = LZ4_compress_HC (src, dst, srcSize, dstCap, LZ4HC_CLEVEL_MIN);
+      block->size = srcSize;
     }
-
-  if (nbytes <= 0)
+  else if (method == RVL_COMPRESSION_LZMA2)
     {
-      rvl_log_fatal ("LZ4 compression failed.");
-      exit (EXIT_FAILURE);
+      size_t dstCap = lzma_block_buffer_bound (srcSize);
+      size_t outPos = 0;
+
+      block->buf = (BYTE *)malloc (dstCap);
+      if (block->buf == NULL)
+        {
+          return LZMA_MEM_ERROR;
+        }
+
+      lzma_ret ret
+          = lzma_raw_buffer_encode (get_lzma_default_filters (), NULL, src,
+                                    srcSize, block->buf, &outPos, dstCap);
+      if (ret != LZMA_OK)
+        {
+          return ret;
+        }
+
+      block->size = (u32)outPos;
+    }
+  else if (method == RVL_COMPRESSION_LZ4)
+    {
+      int dstCap = LZ4_compressBound ((int)srcSize);
+
+      block->buf = (BYTE *)malloc (dstCap);
+      if (block->buf == NULL)
+        {
+          return -1;
+        }
+
+      int nbytes = LZ4_compress_HC ((const char *)src, (char *)block->buf,
+                                    (int)srcSize, dstCap, LZ4HC_CLEVEL_MIN);
+      if (nbytes <= 0)
+        {
+          return -1;
+        }
+
+      block->size = (u32)nbytes;
+    }
+  else
+    {
+      return -1;
     }
 
-  *size = nbytes;
-
-  rvl_log_debug ("Compression succeeded. The result has %u bytes.", nbytes);
+  return 0;
 }
 
-void
-rvl_decompress_lz4 (RVL *self, const BYTE *in, u32 size)
+int
+rvl_decompress_block (RVLCompress method, const BYTE *in, u32 size, BYTE *out,
+                      u32 outSize)
 {
-  const char *src     = (const char *)in;
-  u32         srcSize = size;
-  char       *dst     = (char *)self->data.rbuf;
-  u32         dstCap  = self->data.size;
-
-  int nbytes = LZ4_decompress_safe (src, dst, srcSize, dstCap);
-  if ((u32)nbytes != self->data.size)
+  if (method == RVL_COMPRESSION_NONE)
+    {
+      if (size != outSize)
+        {
+          return -1;
+        }
+      memcpy (out, in, size);
+      return 0;
+    }
+  else if (method == RVL_COMPRESSION_LZMA2)
     {
-      rvl_log_fatal (
-          "Decompression failed. The returned number of bytes is %d.", nbytes);
-      exit (EXIT_FAILURE);
+      size_t inPos  = 0;
+      size_t outPos = 0;
+
+      lzma_ret ret = lzma_raw_buffer_decode (get_lzma_default_filters (), NULL,
+                                             in, &inPos, size, out, &outPos,
+                                             outSize);
+      if (ret != LZMA_OK)
+        {
+          return ret;
+        }
+
+      return (outPos == outSize) ? 0 : LZMA_DATA_ERROR;
+    }
+  else if (method == RVL_COMPRESSION_LZ4)
+    {
+      int nbytes = LZ4_decompress_safe ((const char *)in, (char *)out,
+                                        (int)size, (int)outSize);
+
+      return ((u32)nbytes == outSize) ? 0 : -1;
     }
 
-  rvl_log_debug ("Decompression succeeded. The result has %u bytes.", nbytes);
+  return -1;
 }
 
 lzma_filter *
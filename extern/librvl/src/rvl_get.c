@@ -66,18 +66,23 @@ rvl_get_grid_origin (RVL *self, float *x, float *y, float *z)
 void *
 rvl_get_voxels (RVL *self)
 {
+  if (self->data.rbuf == NULL)
+    {
+      return (void *)self->data.mbuf;
+    }
+
   return (void *)self->data.rbuf;
 }
 
 void *
 rvl_get_voxel_at (RVL *self, int x, int y, int z)
 {
-  u32 nx     = self->resolution[0];
-  u32 ny     = self->resolution[1];
-  u32 index  = (x + y * nx + z * nx * ny);
-  u32 offset = index * rvl_sizeof (self->primitive);
+  u64 nx     = self->resolution[0];
+  u64 ny     = self->resolution[1];
+  u64 index  = (x + y * nx + z * nx * ny);
+  u64 offset = index * rvl_sizeof (self->primitive);
 
-  return (void *)(self->data.rbuf + offset);
+  return (void *)((BYTE *)rvl_get_voxels (self) + offset);
 }
 
 void
@@ -115,7 +120,7 @@ rvl_get_primitive_nbytes (RVL *self)
   return rvl_sizeof (self->primitive);
 }
 
-unsigned int
+unsigned long long
 rvl_get_data_nbytes (RVL *self)
 {
   return rvl_eval_voxels_nbytes (self);
@@ -126,3 +131,9 @@ rvl_get_grid_position (RVL *self, float *x, float *y, float *z)
 {
   rvl_get_grid_origin (self, x, y, z);
 }
+
+const char *
+rvl_get_error (RVL *self)
+{
+  return self->error;
+}
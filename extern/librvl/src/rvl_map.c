@@ -0,0 +1,146 @@
+#ifdef _WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  include <io.h>
+#  include <windows.h>
+#else
+#  define _POSIX_C_SOURCE 200112L
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <sys/types.h>
+#  include <unistd.h>
+#endif
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "rvl.h"
+
+#include "detail/rvl_log_p.h"
+#include "detail/rvl_map_p.h"
+#include "detail/rvl_p.h"
+
+bool
+rvl_map_file (RVL *self, u64 offset, u64 size)
+{
+  rvl_unmap_file (self);
+
+  if (self->io == NULL || size == 0)
+    {
+      return false;
+    }
+
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo (&info);
+
+  const u64 delta   = offset % info.dwAllocationGranularity;
+  const u64 aligned = offset - delta;
+  const u64 length  = size + delta;
+
+  HANDLE file = (HANDLE)_get_osfhandle (_fileno (self->io));
+
+  /* Touching a page past the end of a truncated file would fault. */
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx (file, &fileSize))
+    {
+      rvl_log_error ("GetFileSizeEx failed: error %lu", GetLastError ());
+      return false;
+    }
+  if (offset + size > (u64)fileSize.QuadPart)
+    {
+      rvl_fail (self, "The file is truncated.");
+    }
+
+  HANDLE handle
+      = CreateFileMappingA (file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (handle == NULL)
+    {
+      rvl_log_error ("CreateFileMapping failed: error %lu", GetLastError ());
+      return false;
+    }
+
+  void *addr = MapViewOfFile (handle, FILE_MAP_READ, (DWORD)(aligned >> 32),
+                              (DWORD)aligned, (SIZE_T)length);
+  if (addr == NULL)
+    {
+      rvl_log_error ("MapViewOfFile failed: error %lu", GetLastError ());
+      CloseHandle (handle);
+      return false;
+    }
+
+  self->mapping.handle = handle;
+#else
+  const u64 page    = (u64)sysconf (_SC_PAGESIZE);
+  const u64 delta   = offset % page;
+  const u64 aligned = offset - delta;
+  const u64 length  = size + delta;
+
+  /* Touching a page past the end of a truncated file raises SIGBUS. */
+  struct stat st;
+  if (fstat (fileno (self->io), &st) != 0)
+    {
+      rvl_log_error ("fstat failed.");
+      return false;
+    }
+  if (offset + size > (u64)st.st_size)
+    {
+      rvl_fail (self, "The file is truncated.");
+    }
+
+  void *addr = mmap (NULL, (size_t)length, PROT_READ, MAP_SHARED,
+                     fileno (self->io), (off_t)aligned);
+  if (addr == MAP_FAILED)
+    {
+      rvl_log_error ("mmap failed.");
+      return false;
+    }
+#endif
+
+  self->mapping.addr = addr;
+  self->mapping.size = length;
+  self->data.mbuf    = (const BYTE *)addr + delta;
+
+  rvl_log_debug ("Mapped %" PRIu64 " bytes at offset %" PRIu64 ".", size,
+                 offset);
+
+  return true;
+}
+
+void
+rvl_unmap_file (RVL *self)
+{
+  if (self->mapping.addr == NULL)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile (self->mapping.addr);
+  CloseHandle ((HANDLE)self->mapping.handle);
+  self->mapping.handle = NULL;
+#else
+  munmap (self->mapping.addr, (size_t)self->mapping.size);
+#endif
+
+  self->mapping.addr = NULL;
+  self->mapping.size = 0;
+  self->data.mbuf    = NULL;
+}
+
+void
+rvl_fseek (RVL *self, u64 offset)
+{
+#ifdef _WIN32
+  _fseeki64 (self->io, (__int64)offset, SEEK_SET);
+#else
+  fseeko (self->io, (off_t)offset, SEEK_SET);
+#endif
+}
+
+u64
+rvl_ftell (RVL *self)
+{
+#ifdef _WIN32
+  return (u64)_ftelli64 (self->io);
+#else
+  return (u64)ftello (self->io);
+#endif
+}
@@ -1,3 +1,4 @@
+#include <inttypes.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -7,7 +8,9 @@
 
 #include "detail/rvl_compress_p.h"
 #include "detail/rvl_log_p.h"
+#include "detail/rvl_map_p.h"
 #include "detail/rvl_p.h"
+#include "detail/rvl_region_p.h"
 #include "detail/rvl_text_p.h"
 
 static void rvl_read_chunk_header (RVL *self, u32 *code, u32 *size);
@@ -16,6 +19,7 @@ static void rvl_read_chunk_end (RVL *self);
 
 static void rvl_handle_VFMT_chunk (RVL *self, u32 size);
 static void rvl_handle_GRID_chunk (RVL *self, u32 size);
+static void rvl_handle_BIDX_chunk (RVL *self, u32 size);
 static void rvl_handle_DATA_chunk (RVL *self, u32 size);
 static void rvl_handle_TEXT_chunk (RVL *self, u32 size);
 static void rvl_handle_VEND_chunk (RVL *self);
@@ -30,6 +34,7 @@ rvl_read_rvl (RVL *self)
     return;
 
   rvl_read_file_sig (self);
+  rvl_dealloc_blocks (self);
 
   RVLChunkCode code;
   do
@@ -45,13 +50,16 @@ rvl_read_rvl (RVL *self)
         {
         case RVL_CHUNK_CODE_VFMT:
           rvl_handle_VFMT_chunk (self, size);
+          rvl_alloc (self, &self->data.rbuf, self->data.size);
           break;
         case RVL_CHUNK_CODE_GRID:
           rvl_alloc (self, &self->grid.dimBuf, size - 14);
           rvl_handle_GRID_chunk (self, size);
           break;
+        case RVL_CHUNK_CODE_BIDX:
+          rvl_handle_BIDX_chunk (self, size);
+          break;
         case RVL_CHUNK_CODE_DATA:
-          rvl_alloc (self, &self->data.rbuf, self->data.size);
           rvl_handle_DATA_chunk (self, size);
           break;
         case RVL_CHUNK_CODE_TEXT:
@@ -102,12 +110,12 @@ rvl_read_info (RVL *self)
           rvl_handle_VEND_chunk (self);
           break;
         default:
-          fseek (self->io, size + sizeof (u32), SEEK_CUR);
+          rvl_fseek (self, rvl_ftell (self) + size + sizeof (u32));
           break;
         }
     }
   while (code != RVL_CHUNK_CODE_VEND);
-  fseek (self->io, RVL_FILE_SIG_SIZE, SEEK_SET);
+  rvl_fseek (self, RVL_FILE_SIG_SIZE);
 }
 
 void
@@ -116,7 +124,9 @@ rvl_read_voxels_to (RVL *self, void *buffer)
   if (self == NULL)
     return;
 
-  self->data.rbuf = buffer;
+  self->data.rbuf         = buffer;
+  self->data.rbufBorrowed = true;
+  rvl_dealloc_blocks (self);
 
   RVLChunkCode code;
   do
@@ -124,20 +134,180 @@ rvl_read_voxels_to (RVL *self, void *buffer)
       u32 size;
       rvl_read_chunk_header (self, &code, &size);
 
-      if (code == RVL_CHUNK_CODE_DATA)
+      switch (code)
         {
+        case RVL_CHUNK_CODE_VFMT:
+          rvl_handle_VFMT_chunk (self, size);
+          break;
+        case RVL_CHUNK_CODE_BIDX:
+          rvl_handle_BIDX_chunk (self, size);
+          break;
+        case RVL_CHUNK_CODE_DATA:
           rvl_handle_DATA_chunk (self, size);
           break;
+        case RVL_CHUNK_CODE_VEND:
+          rvl_handle_VEND_chunk (self);
+          break;
+        default:
+          // Skip the payload and the CRC.
+          rvl_fseek (self, rvl_ftell (self) + size + sizeof (u32));
+          break;
         }
-      else
+    }
+  while (code != RVL_CHUNK_CODE_VEND
+         && (self->data.blocks == NULL
+             || self->data.nread < self->data.nblocks));
+
+  self->data.rbuf         = NULL;
+  self->data.rbufBorrowed = false;
+  rvl_dealloc_blocks (self);
+  rvl_fseek (self, RVL_FILE_SIG_SIZE);
+}
+
+const void *
+rvl_map_voxels (RVL *self)
+{
+  if (self == NULL)
+    return NULL;
+
+  rvl_unmap_file (self);
+  rvl_dealloc_blocks (self);
+
+  const void  *voxels = NULL;
+  RVLChunkCode code;
+  do
+    {
+      u32 size;
+      rvl_read_chunk_header (self, &code, &size);
+
+      if (code == RVL_CHUNK_CODE_VFMT)
+        {
+          rvl_handle_VFMT_chunk (self, size);
+        }
+      else if (code == RVL_CHUNK_CODE_BIDX)
+        {
+          rvl_handle_BIDX_chunk (self, size);
+        }
+      else if (code == RVL_CHUNK_CODE_DATA)
         {
-          fseek (self->io, size, SEEK_CUR);
+          if (self->compress != RVL_COMPRESSION_NONE)
+            {
+              rvl_log_error ("Only uncompressed voxel data can be mapped.");
+            }
+          else if (self->data.nblocks > 1 || size != self->data.size)
+            {
+              rvl_log_error ("The voxel data is split into %u blocks and "
+                             "cannot be mapped.",
+                             self->data.nblocks);
+            }
+          else if (rvl_map_file (self, rvl_ftell (self), size))
+            {
+              voxels = self->data.mbuf;
+            }
+          break;
+        }
+      else if (code != RVL_CHUNK_CODE_VEND)
+        {
+          rvl_fseek (self, rvl_ftell (self) + size + sizeof (u32));
+        }
+    }
+  while (code != RVL_CHUNK_CODE_VEND);
+
+  rvl_dealloc_blocks (self);
+  rvl_fseek (self, RVL_FILE_SIG_SIZE);
+
+  return voxels;
+}
+
+void
+rvl_read_block_index (RVL *self)
+{
+  rvl_dealloc_blocks (self);
+
+  rvl_fseek (self, 0);
+  rvl_read_file_sig (self);
+
+  RVLChunkCode code;
+  do
+    {
+      u32 size;
+      rvl_read_chunk_header (self, &code, &size);
+
+      if (code == RVL_CHUNK_CODE_VFMT)
+        {
+          rvl_handle_VFMT_chunk (self, size);
+        }
+      else if (code == RVL_CHUNK_CODE_BIDX)
+        {
+          rvl_handle_BIDX_chunk (self, size);
+          break;
+        }
+      else if (code == RVL_CHUNK_CODE_DATA)
+        {
+          // Without a block index, the voxels are a single block (v0.7).
+          if (self->data.size > UINT32_MAX)
+            {
+              rvl_fail (self, "DATA chunk without a block index is too "
+                              "large.");
+            }
+          rvl_alloc_blocks (self, (u32)self->data.size, 1);
+          self->data.blocks[0].size   = size;
+          self->data.blocks[0].offset = rvl_ftell (self);
+          break;
+        }
+      else if (code != RVL_CHUNK_CODE_VEND)
+        {
+          rvl_fseek (self, rvl_ftell (self) + size + sizeof (u32));
         }
     }
   while (code != RVL_CHUNK_CODE_VEND);
 
-  self->data.rbuf = NULL;
-  fseek (self->io, RVL_FILE_SIG_SIZE, SEEK_SET);
+  rvl_fseek (self, RVL_FILE_SIG_SIZE);
+
+  if (self->data.blocks == NULL)
+    {
+      rvl_fail (self, "The file has no voxel data.");
+    }
+}
+
+void
+rvl_read_block (RVL *self, u32 index, BYTE *out)
+{
+  const RVLBlock *block  = &self->data.blocks[index];
+  const u32       nbytes = rvl_block_nbytes (self, index);
+
+  u32 code, size;
+  rvl_fseek (self, block->offset - 2 * sizeof (u32));
+  rvl_read_chunk_header (self, &code, &size);
+
+  if (code != RVL_CHUNK_CODE_DATA || size != block->size)
+    {
+      rvl_fail (self, "DATA chunk does not match the block index.");
+    }
+
+  if (self->compress == RVL_COMPRESSION_NONE)
+    {
+      if (size != nbytes)
+        {
+          rvl_fail (self, "DATA chunk does not match the block index.");
+        }
+      rvl_read_chunk_payload (self, out, size);
+      rvl_read_chunk_end (self);
+      return;
+    }
+
+  BYTE *buf = rvl_chunk_buffer (self, size);
+  rvl_read_chunk_payload (self, buf, size);
+  rvl_read_chunk_end (self);
+
+  int ret = rvl_decompress_block (self->compress, buf, size, out, nbytes);
+
+  if (ret != 0)
+    {
+      rvl_fail (self, "Decompression of block %u failed. Possibly file "
+                      "corruption.",
+                      index);
+    }
 }
 
 void
@@ -179,31 +349,35 @@ rvl_read_chunk_end (RVL *self)
 
   if (crc1 != crc2)
     {
-      rvl_log_fatal ("CRC failed. Possibly file corruption.");
-      exit (EXIT_FAILURE);
+      rvl_fail (self, "CRC failed. Possibly file corruption.");
     }
 }
 
 void
 rvl_handle_VFMT_chunk (RVL *self, u32 size)
 {
-  BYTE *rbuf = (BYTE *)malloc (size);
+  BYTE *rbuf = rvl_chunk_buffer (self, size);
   rvl_read_chunk_payload (self, rbuf, size);
   rvl_read_chunk_end (self);
 
+  if (size < 18)
+    {
+      rvl_fail (self, "VFMT chunk is too short.");
+    }
+
   RVLPrimitive primitive;
   RVLEndian    endian;
   RVLCompress  compress;
 
+  // v0.7 files have a single DATA chunk without a block index.
   u8 major = (u8)rbuf[0];
   u8 minor = (u8)rbuf[1];
-  if (minor != RVL_VERSION_MINOR /* before v1.0.0 */
+  if ((minor != RVL_VERSION_MINOR && minor != 7) /* before v1.0.0 */
       || major != RVL_VERSION_MAJOR)
     {
-      rvl_log_fatal ("The file was created in an incompatible version: "
-                     "v%d.%d (currently v%d.%d).",
-                     major, minor, RVL_VERSION_MAJOR, RVL_VERSION_MINOR);
-      exit (EXIT_FAILURE);
+      rvl_fail (self, "The file was created in an incompatible version: "
+                      "v%d.%d (currently v%d.%d).",
+                      major, minor, RVL_VERSION_MAJOR, RVL_VERSION_MINOR);
     }
 
   memcpy (&self->resolution, &rbuf[2], 12);
@@ -216,14 +390,12 @@ rvl_handle_VFMT_chunk (RVL *self, u32 size)
   self->compress  = compress;
 
   self->data.size = rvl_eval_voxels_nbytes (self);
-
-  free (rbuf);
 }
 
 void
 rvl_handle_GRID_chunk (RVL *self, u32 size)
 {
-  BYTE *rbuf = (BYTE *)malloc (size);
+  BYTE *rbuf = rvl_chunk_buffer (self, size);
   rvl_read_chunk_payload (self, rbuf, size);
   rvl_read_chunk_end (self);
 
@@ -253,39 +425,116 @@ rvl_handle_GRID_chunk (RVL *self, u32 size)
       szdz      = r[2] * sizeof (f32);
     }
 
+  if (size < offset + (u64)szdx + szdy + szdz)
+    {
+      rvl_fail (self, "GRID chunk is too short.");
+    }
+
   grid->dx = (float *)(grid->dimBuf);
   grid->dy = (float *)(grid->dimBuf + szdx);
   grid->dz = (float *)(grid->dimBuf + szdx + szdy);
   memcpy (grid->dx, &rbuf[offset], szdx);
   memcpy (grid->dy, &rbuf[offset + szdx], szdy);
   memcpy (grid->dz, &rbuf[offset + szdx + szdy], szdz);
-
-  free (rbuf);
 }
 
 void
-rvl_handle_DATA_chunk (RVL *self, u32 size)
+rvl_handle_BIDX_chunk (RVL *self, u32 size)
 {
-  BYTE *rbuf = (BYTE *)malloc (size);
+  BYTE *rbuf = rvl_chunk_buffer (self, size);
   rvl_read_chunk_payload (self, rbuf, size);
   rvl_read_chunk_end (self);
 
-  if (self->compress == RVL_COMPRESSION_LZ4)
+  if (size < 16)
     {
-      rvl_decompress_lz4 (self, rbuf, size);
+      rvl_fail (self, "BIDX chunk is too short.");
     }
-  else if (self->compress == RVL_COMPRESSION_LZMA2)
+
+  u64 dataSize;
+  u32 blockSize, nblocks;
+  memcpy (&dataSize, &rbuf[0], 8);
+  memcpy (&blockSize, &rbuf[8], 4);
+  memcpy (&nblocks, &rbuf[12], 4);
+
+  if (dataSize != self->data.size || blockSize == 0
+      || nblocks != (dataSize + blockSize - 1) / blockSize
+      || size != 16 + 4 * (u64)nblocks)
     {
-      rvl_decompress_lzma (self, rbuf, size);
+      rvl_fail (self, "Invalid block index: %" PRIu64 " bytes in %u blocks "
+                      "of %u bytes.",
+                      dataSize, nblocks, blockSize);
     }
 
-  free (rbuf);
+  // The DATA chunks follow the index, so their positions are known without
+  // reading them.
+  u64 offset = rvl_ftell (self);
+  rvl_alloc_blocks (self, blockSize, nblocks);
+  for (u32 i = 0; i < nblocks; i++)
+    {
+      RVLBlock *block = &self->data.blocks[i];
+      memcpy (&block->size, &rbuf[16 + 4 * i], 4);
+      block->offset = offset + 2 * sizeof (u32);
+      offset += 3 * sizeof (u32) + block->size;
+    }
+}
+
+// Collect the compressed blocks and decompress them all at once after the
+// last one.
+void
+rvl_handle_DATA_chunk (RVL *self, u32 size)
+{
+  RVLData *data = &self->data;
+
+  // Without a block index, the voxels are a single block (v0.7).
+  if (data->blocks == NULL)
+    {
+      if (data->size > UINT32_MAX)
+        {
+          rvl_fail (self, "DATA chunk without a block index is too large.");
+        }
+      rvl_alloc_blocks (self, (u32)data->size, 1);
+      data->blocks[0].size   = size;
+      data->blocks[0].offset = rvl_ftell (self);
+    }
+
+  if (data->nread >= data->nblocks || data->blocks[data->nread].size != size)
+    {
+      rvl_fail (self, "DATA chunk does not match the block index.");
+    }
+
+  // Stored blocks are read in place.
+  if (self->compress == RVL_COMPRESSION_NONE)
+    {
+      const u64 offset = (u64)data->nread * data->blockSize;
+      if (size > data->size - offset)
+        {
+          rvl_fail (self, "DATA chunk exceeds the size of the voxel data.");
+        }
+      rvl_read_chunk_payload (self, data->rbuf + offset, size);
+      rvl_read_chunk_end (self);
+      data->nread++;
+      return;
+    }
+
+  RVLBlock *block = &data->blocks[data->nread];
+  block->buf      = (BYTE *)malloc (size);
+  if (block->buf == NULL)
+    {
+      rvl_fail (self, "Memory allocation failure.");
+    }
+  rvl_read_chunk_payload (self, block->buf, size);
+  rvl_read_chunk_end (self);
+
+  if (++data->nread == data->nblocks)
+    {
+      rvl_decompress_blocks (self);
+    }
 }
 
 void
 rvl_handle_TEXT_chunk (RVL *self, u32 size)
 {
-  BYTE *rbuf = (BYTE *)malloc (size);
+  BYTE *rbuf = rvl_chunk_buffer (self, size);
   rvl_read_chunk_payload (self, rbuf, size);
   rvl_read_chunk_end (self);
 
@@ -297,12 +546,16 @@ rvl_handle_TEXT_chunk (RVL *self, u32 size)
 
   u32 valueLen = size - 1;
   text->value  = (char *)malloc (valueLen + 1);
+  if (text->value == NULL)
+    {
+      rvl_text_destroy (&text);
+      rvl_fail (self, "Memory allocation failure.");
+    }
 
   text->value[valueLen] = '\0';
   memcpy (text->value, &rbuf[1], valueLen);
 
   rvl_log_debug ("Read TEXT: %.4X, %s", text->tag, text->value);
-  free (rbuf);
 
   if (self->text == NULL)
     {
@@ -336,8 +589,7 @@ rvl_read_file_sig (RVL *self)
     {
       if (sig[i] != RVL_FILE_SIG[i])
         {
-          rvl_log_fatal ("Not an RVL file.");
-          exit (EXIT_FAILURE);
+          rvl_fail (self, "Not an RVL file.");
         }
     }
 }
@@ -347,9 +599,8 @@ rvl_fread (RVL *self, BYTE *data, u32 size)
 {
   if (self->readFn == NULL)
     {
-      rvl_log_fatal ("Call to NULL read function. Please check if "
-                     "the RVL instance is a reader.");
-      exit (EXIT_FAILURE);
+      rvl_fail (self, "Call to NULL read function. Please check if "
+                      "the RVL instance is a reader.");
     }
 
   self->readFn (self, data, size);
@@ -358,11 +609,15 @@ rvl_fread (RVL *self, BYTE *data, u32 size)
 void
 rvl_fread_default (RVL *self, BYTE *data, u32 size)
 {
+  if (self->io == NULL)
+    {
+      rvl_fail (self, "No file to read from.");
+    }
+
   const size_t count = fread (data, 1, size, self->io);
 
   if (count != size)
     {
-      rvl_log_fatal ("Failed to read from file stream.");
-      exit (EXIT_FAILURE);
+      rvl_fail (self, "Failed to read from file stream.");
     }
 }
@@ -0,0 +1,164 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "rvl.h"
+
+#include "detail/rvl_log_p.h"
+#include "detail/rvl_map_p.h"
+#include "detail/rvl_p.h"
+#include "detail/rvl_region_p.h"
+
+static const BYTE *rvl_get_cached_block (RVL *self, u32 index);
+static void rvl_copy_from_blocks (RVL *self, u64 offset, u64 size, BYTE *out);
+
+void
+rvl_read_region (RVL *self, int x0, int y0, int z0, int nx, int ny, int nz,
+                 void *buffer)
+{
+  if (self == NULL)
+    return;
+
+  // Voxels that are already in memory are copied from there.
+  const BYTE *voxels
+      = self->data.rbuf != NULL ? self->data.rbuf : self->data.mbuf;
+
+  if (voxels == NULL
+      && (self->data.blocks == NULL || self->data.blocks[0].offset == 0))
+    {
+      rvl_read_block_index (self);
+    }
+
+  const u32 *r = self->resolution;
+  if (x0 < 0 || y0 < 0 || z0 < 0 || nx <= 0 || ny <= 0 || nz <= 0
+      || (u64)x0 + nx > r[0] || (u64)y0 + ny > r[1] || (u64)z0 + nz > r[2])
+    {
+      rvl_log_error ("Region at (%d, %d, %d) of size (%d, %d, %d) is out of "
+                     "the bounds of the volume.",
+                     x0, y0, z0, nx, ny, nz);
+      return;
+    }
+
+  const u64 nbytes  = rvl_sizeof (self->primitive);
+  const u64 rowSize = nx * nbytes;
+  BYTE     *out     = (BYTE *)buffer;
+
+  for (int z = z0; z < z0 + nz; z++)
+    {
+      for (int y = y0; y < y0 + ny; y++)
+        {
+          const u64 offset = (((u64)z * r[1] + y) * r[0] + x0) * nbytes;
+
+          if (voxels != NULL)
+            {
+              memcpy (out, voxels + offset, rowSize);
+            }
+          else
+            {
+              rvl_copy_from_blocks (self, offset, rowSize, out);
+            }
+
+          out += rowSize;
+        }
+    }
+
+  if (voxels == NULL)
+    {
+      rvl_fseek (self, RVL_FILE_SIG_SIZE);
+    }
+}
+
+void
+rvl_set_block_cache_size (RVL *self, unsigned int count)
+{
+  rvl_clear_block_cache (self);
+  self->cache.capacity = count > 0 ? count : 1;
+}
+
+void
+rvl_clear_block_cache (RVL *self)
+{
+  RVLBlockCache *cache = &self->cache;
+
+  if (cache->entries == NULL)
+    return;
+
+  for (u32 i = 0; i < cache->capacity; i++)
+    {
+      free (cache->entries[i].buf);
+    }
+
+  free (cache->entries);
+  cache->entries = NULL;
+  cache->clock   = 0;
+}
+
+void
+rvl_copy_from_blocks (RVL *self, u64 offset, u64 size, BYTE *out)
+{
+  const u32 blockSize = self->data.blockSize;
+
+  while (size > 0)
+    {
+      const u32 index = (u32)(offset / blockSize);
+      const u32 begin = (u32)(offset % blockSize);
+      const u32 avail = rvl_block_nbytes (self, index) - begin;
+      const u64 count = avail < size ? avail : size;
+
+      memcpy (out, rvl_get_cached_block (self, index) + begin, count);
+
+      offset += count;
+      size -= count;
+      out += count;
+    }
+}
+
+// Unused entries have never been used, so the least recently used entry is
+// also the first unused one if there is any.
+const BYTE *
+rvl_get_cached_block (RVL *self, u32 index)
+{
+  RVLBlockCache *cache = &self->cache;
+
+  if (cache->entries == NULL)
+    {
+      cache->entries
+          = (RVLCacheEntry *)calloc (cache->capacity, sizeof (RVLCacheEntry));
+      if (cache->entries == NULL)
+        {
+          rvl_fail (self, "Memory allocation failure.");
+        }
+    }
+
+  RVLCacheEntry *victim = &cache->entries[0];
+  for (u32 i = 0; i < cache->capacity; i++)
+    {
+      RVLCacheEntry *entry = &cache->entries[i];
+      if (entry->buf != NULL && entry->block == index)
+        {
+          entry->lastUse = ++cache->clock;
+          return entry->buf;
+        }
+      if (entry->lastUse < victim->lastUse)
+        {
+          victim = entry;
+        }
+    }
+
+  if (victim->buf == NULL)
+    {
+      victim->buf = (BYTE *)malloc (self->data.blockSize);
+      if (victim->buf == NULL)
+        {
+          rvl_fail (self, "Memory allocation failure.");
+        }
+    }
+
+  // The entry stays invalid if the block cannot be decoded.
+  victim->block = UINT32_MAX;
+  rvl_log_debug ("Decoding block %u for a region.", index);
+  rvl_read_block (self, index, victim->buf);
+
+  victim->block   = index;
+  victim->lastUse = ++cache->clock;
+  return victim->buf;
+}
@@ -5,7 +5,9 @@
 #include "rvl.h"
 
 #include "detail/rvl_log_p.h"
+#include "detail/rvl_map_p.h"
 #include "detail/rvl_p.h"
+#include "detail/rvl_region_p.h"
 #include "detail/rvl_text_p.h"
 
 static void rvl_set_voxel_dims (RVL *self, float dx, float dy, float dz);
@@ -15,6 +17,10 @@ void
 rvl_set_file (RVL *self, const char *filename)
 {
 
+  rvl_unmap_file (self);
+  rvl_dealloc_blocks (self);
+  rvl_clear_block_cache (self);
+
   if (self->isOwningIo && self->io != NULL)
     {
       rvl_log_debug ("Closing old file stream...");
@@ -43,6 +49,10 @@ rvl_set_file (RVL *self, const char *filename)
 void
 rvl_set_io (RVL *self, FILE *stream)
 {
+  rvl_unmap_file (self);
+  rvl_dealloc_blocks (self);
+  rvl_clear_block_cache (self);
+
   if (self->isOwningIo && self->io != NULL)
     {
       rvl_log_debug ("Closing old file stream...");
@@ -145,6 +155,18 @@ rvl_set_voxel_dims_v (RVL *self, int ndx, int ndy, int ndz, float *dx,
   memcpy (self->grid.dz, dz, szdz);
 }
 
+void
+rvl_set_block_size (RVL *self, unsigned int size)
+{
+  if (size == 0 || size > RVL_MAX_BLOCK_SIZE)
+    {
+      rvl_log_error ("Invalid block size: %u bytes.", size);
+      return;
+    }
+
+  self->data.blockSize = size;
+}
+
 void
 rvl_set_voxels (RVL *self, const void *voxels)
 {
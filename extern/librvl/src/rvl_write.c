@@ -16,6 +16,7 @@ static void rvl_write_chunk_end (RVL *self);
 
 static void rvl_handle_VFMT_chunk (RVL *self);
 static void rvl_handle_GRID_chunk (RVL *self);
+static void rvl_handle_BIDX_chunk (RVL *self);
 static void rvl_handle_DATA_chunk (RVL *self);
 static void rvl_handle_TEXT_chunk (RVL *self);
 static void rvl_handle_VEND_chunk (RVL *self);
@@ -37,6 +38,7 @@ rvl_write_rvl (RVL *self)
   // Required chunks
   rvl_handle_VFMT_chunk (self);
   rvl_handle_GRID_chunk (self);
+  rvl_handle_BIDX_chunk (self);
   rvl_handle_DATA_chunk (self);
 
   if (self->text != NULL)
@@ -76,6 +78,10 @@ rvl_handle_GRID_chunk (RVL *self)
   u32   offset   = 14;
   u32   wbufSize = offset + self->grid.dimBufSz;
   BYTE *wbuf     = (BYTE *)malloc (wbufSize);
+  if (wbuf == NULL)
+    {
+      rvl_fail (self, "Memory allocation failure.");
+    }
 
   RVLGridType type = self->grid.type;
   RVLGridUnit unit = self->grid.unit;
@@ -102,28 +108,71 @@ rvl_handle_GRID_chunk (RVL *self)
   free (wbuf);
 }
 
+// Compress the blocks, which must be done before their sizes can be indexed.
 void
-rvl_handle_DATA_chunk (RVL *self)
+rvl_handle_BIDX_chunk (RVL *self)
 {
-  u32   wbufSize = self->data.size;
-  BYTE *wbuf     = (BYTE *)malloc (wbufSize);
+  RVLData *data      = &self->data;
+  u32      blockSize = data->blockSize;
 
-  if (self->compress == RVL_COMPRESSION_LZMA2)
+  // Keep stored data in one piece so that it can be mapped.
+  if (self->compress == RVL_COMPRESSION_NONE && data->size <= UINT32_MAX)
     {
-      rvl_compress_lzma (self, &wbuf, &wbufSize);
+      blockSize = (u32)data->size;
     }
-  else if (self->compress == RVL_COMPRESSION_LZ4)
+
+  const u32 nblocks = (u32)((data->size + blockSize - 1) / blockSize);
+
+  rvl_alloc_blocks (self, blockSize, nblocks);
+  rvl_compress_blocks (self);
+
+  u32   wbufSize = 16 + 4 * nblocks;
+  BYTE *wbuf     = (BYTE *)malloc (wbufSize);
+  if (wbuf == NULL)
+    {
+      rvl_fail (self, "Memory allocation failure.");
+    }
+
+  memcpy (&wbuf[0], &data->size, 8);
+  memcpy (&wbuf[8], &data->blockSize, 4);
+  memcpy (&wbuf[12], &data->nblocks, 4);
+  for (u32 i = 0; i < nblocks; i++)
     {
-      rvl_compress_lz4 (self, &wbuf, &wbufSize);
+      memcpy (&wbuf[16 + 4 * i], &data->blocks[i].size, 4);
     }
 
-  rvl_write_chunk_header (self, RVL_CHUNK_CODE_DATA, wbufSize);
-  rvl_write_chunk_payload (self, (const BYTE *)wbuf, wbufSize);
+  rvl_write_chunk_header (self, RVL_CHUNK_CODE_BIDX, wbufSize);
+  rvl_write_chunk_payload (self, wbuf, wbufSize);
   rvl_write_chunk_end (self);
 
   free (wbuf);
 }
 
+// Write one DATA chunk per block.
+void
+rvl_handle_DATA_chunk (RVL *self)
+{
+  for (u32 i = 0; i < self->data.nblocks; i++)
+    {
+      RVLBlock   *block   = &self->data.blocks[i];
+      const BYTE *payload = block->buf;
+
+      if (self->compress == RVL_COMPRESSION_NONE)
+        {
+          payload = self->data.wbuf + (u64)i * self->data.blockSize;
+        }
+
+      rvl_write_chunk_header (self, RVL_CHUNK_CODE_DATA, block->size);
+      rvl_write_chunk_payload (self, payload, block->size);
+      rvl_write_chunk_end (self);
+
+      free (block->buf);
+      block->buf = NULL;
+    }
+
+  rvl_dealloc_blocks (self);
+}
+
 // Strip off the null terminator at the end of the value string.
 void
 rvl_handle_TEXT_chunk (RVL *self)
@@ -199,9 +248,8 @@ rvl_fwrite (RVL *self, const BYTE *data, u32 size)
 {
   if (self->writeFn == NULL)
     {
-      rvl_log_fatal ("Call to NULL write function. Please check if "
-                     "the RVL instance is a writer.");
-      exit (EXIT_FAILURE);
+      rvl_fail (self, "Call to NULL write function. Please check if "
+                      "the RVL instance is a writer.");
     }
 
   self->writeFn (self, data, size);
@@ -214,8 +262,7 @@ rvl_fwrite_default (RVL *self, const BYTE *data, u32 size)
 
   if (count != size)
     {
-      rvl_log_fatal ("Failed to write to file stream.");
-      exit (EXIT_FAILURE);
+      rvl_fail (self, "Failed to write to file stream.");
     }
 }
 
@@ -224,14 +271,12 @@ check_data (RVL *self)
 {
   if (self->data.size <= 0)
     {
-      rvl_log_fatal ("Size of data is less than 0.");
-      exit (EXIT_FAILURE);
+      rvl_fail (self, "Size of data is less than 0.");
     }
 
   if (self->data.size != rvl_eval_voxels_nbytes (self))
     {
-      rvl_log_fatal ("Size of data does not match the header information.");
-      exit (EXIT_FAILURE);
+      rvl_fail (self, "Size of data does not match the header information.");
     }
 }
 
@@ -240,8 +285,7 @@ check_grid (RVL *self)
 {
   if (self->grid.ndx <= 0 || self->grid.ndy <= 0 || self->grid.ndz <= 0)
     {
-      rvl_log_fatal ("Missing voxel dimensions.");
-      exit (EXIT_FAILURE);
+      rvl_fail (self, "Missing voxel dimensions.");
     }
 
   switch (self->grid.type)
@@ -249,9 +293,8 @@ check_grid (RVL *self)
     case RVL_GRID_REGULAR:
       if (self->grid.ndx != 1 || self->grid.ndy != 1 || self->grid.ndz != 1)
         {
-          rvl_log_fatal ("Number of voxel dimensions is not valid "
-                         "for regular grid.");
-          exit (EXIT_FAILURE);
+          rvl_fail (self, "Number of voxel dimensions is not valid "
+                          "for regular grid.");
         }
       break;
     case RVL_GRID_RECTILINEAR:
@@ -260,15 +303,13 @@ check_grid (RVL *self)
         if (self->grid.ndx != r[0] || self->grid.ndy != r[1]
             || self->grid.ndz != r[2])
           {
-            rvl_log_fatal ("Number of voxel dimensions do not match "
-                           "the resolution.");
-            exit (EXIT_FAILURE);
+            rvl_fail (self, "Number of voxel dimensions do not match "
+                            "the resolution.");
           }
       }
       break;
     default:
-      rvl_log_fatal ("Invalid grid type: %.2x.", self->grid.type);
-      exit (EXIT_FAILURE);
+      rvl_fail (self, "Invalid grid type: %.2x.", self->grid.type);
       break;
     }
 }
@@ -0,0 +1,57 @@
+#include <rvl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * A 4x3x2 U8 volume with LZ4 compression and a title, written by librvl v0.7.
+ * The voxels are i * 7 + 1 in storage order.
+ */
+static const unsigned char LEGACY_FILE[] = {
+  131, 82, 86, 76, 32, 70, 79, 82, 77, 65, 84, 0,
+  18, 0, 0, 0, 86, 70, 77, 84, 0, 7, 4, 0,
+  0, 0, 3, 0, 0, 0, 2, 0, 0, 0, 3, 1,
+  1, 1, 250, 217, 147, 100, 26, 0, 0, 0, 71, 82,
+  73, 68, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 63, 0, 0, 0, 63,
+  0, 0, 0, 63, 152, 62, 114, 162, 26, 0, 0, 0,
+  68, 65, 84, 65, 240, 9, 1, 8, 15, 22, 29, 36,
+  43, 50, 57, 64, 71, 78, 85, 92, 99, 106, 113, 120,
+  127, 134, 141, 148, 155, 162, 237, 196, 189, 37, 5, 0,
+  0, 0, 84, 69, 88, 84, 1, 118, 48, 46, 55, 126,
+  81, 252, 210, 0, 0, 0, 0, 86, 69, 78, 68, 168,
+  7, 131, 120,
+};
+
+int
+main ()
+{
+  FILE *file = fopen ("legacy_format.rvl", "wb");
+  fwrite (LEGACY_FILE, 1, sizeof (LEGACY_FILE), file);
+  fclose (file);
+
+  RVL *rvl = rvl_create_reader ();
+  rvl_set_file (rvl, "legacy_format.rvl");
+  rvl_read_rvl (rvl);
+
+  RVLenum prm, endian;
+  int     nx, ny, nz;
+  rvl_get_volumetric_format (rvl, &nx, &ny, &nz, &prm, &endian);
+
+  if (nx != 4 || ny != 3 || nz != 2 || prm != RVL_PRIMITIVE_U8
+      || strcmp (rvl_get_text_value (rvl, RVL_TEXT_TITLE), "v0.7") != 0)
+    {
+      exit (EXIT_FAILURE);
+    }
+
+  const unsigned char *voxels = (const unsigned char *)rvl_get_voxels (rvl);
+  for (int i = 0; i < nx * ny * nz; i++)
+    {
+      if (voxels[i] != (unsigned char)(i * 7 + 1))
+        {
+          exit (EXIT_FAILURE);
+        }
+    }
+
+  rvl_destroy (&rvl);
+}
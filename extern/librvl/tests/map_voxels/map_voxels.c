@@ -0,0 +1,86 @@
+#include <rvl.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NX 37
+#define NY 41
+#define NZ 43
+
+static unsigned char VOXELS[NX * NY * NZ];
+
+void
+genVoxels ()
+{
+  for (int i = 0; i < NX * NY * NZ; i++)
+    {
+      VOXELS[i] = (unsigned char)((i * 31) ^ (i >> 7));
+    }
+}
+
+void
+writeFile (const char *filename, RVLenum compression)
+{
+  RVL *rvl = rvl_create_writer ();
+  rvl_set_volumetric_format (rvl, NX, NY, NZ, RVL_PRIMITIVE_U8,
+                             RVL_ENDIAN_LITTLE);
+  rvl_set_regular_grid (rvl, 1.0f, 1.0f, 1.0f);
+  rvl_set_compression (rvl, compression);
+  rvl_set_block_size (rvl, 4096);
+  rvl_set_text (rvl, RVL_TEXT_TITLE, "Stored");
+  rvl_set_voxels (rvl, VOXELS);
+
+  rvl_set_file (rvl, filename);
+  rvl_write_rvl (rvl);
+  rvl_destroy (&rvl);
+}
+
+int
+main ()
+{
+  genVoxels ();
+  writeFile ("map_voxels.rvl", RVL_COMPRESSION_NONE);
+
+  // Mapped, and then read again through the stream
+  RVL *rvl = rvl_create_reader ();
+  rvl_set_file (rvl, "map_voxels.rvl");
+  rvl_read_info (rvl);
+
+  const void *mapped = rvl_map_voxels (rvl);
+  if (mapped == NULL || mapped != rvl_get_voxels (rvl)
+      || memcmp (mapped, VOXELS, sizeof (VOXELS)) != 0
+      || *(unsigned char *)rvl_get_voxel_at (rvl, 3, 5, 7)
+             != VOXELS[3 + 5 * NX + 7 * NX * NY])
+    {
+      exit (EXIT_FAILURE);
+    }
+
+  unsigned char *buffer = (unsigned char *)malloc (sizeof (VOXELS));
+  rvl_read_voxels_to (rvl, buffer);
+  if (memcmp (buffer, VOXELS, sizeof (VOXELS)) != 0)
+    {
+      exit (EXIT_FAILURE);
+    }
+  free (buffer);
+  rvl_destroy (&rvl);
+
+  // Stored voxels through the regular reader
+  rvl = rvl_create_reader ();
+  rvl_set_file (rvl, "map_voxels.rvl");
+  rvl_read_rvl (rvl);
+  if (memcmp (rvl_get_voxels (rvl), VOXELS, sizeof (VOXELS)) != 0)
+    {
+      exit (EXIT_FAILURE);
+    }
+  rvl_destroy (&rvl);
+
+  // Compressed voxels cannot be mapped.
+  writeFile ("map_voxels_lz4.rvl", RVL_COMPRESSION_LZ4);
+  rvl = rvl_create_reader ();
+  rvl_set_file (rvl, "map_voxels_lz4.rvl");
+  rvl_read_info (rvl);
+  if (rvl_map_voxels (rvl) != NULL)
+    {
+      exit (EXIT_FAILURE);
+    }
+  rvl_destroy (&rvl);
+}
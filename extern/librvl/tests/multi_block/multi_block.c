@@ -0,0 +1,99 @@
+#include <rvl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NX 61
+#define NY 47
+#define NZ 29
+
+// Not a multiple of the data size, so the last block is shorter.
+#define BLOCK_SIZE 4000
+
+static uint16_t VOXELS[NX * NY * NZ];
+
+void
+genVoxels ()
+{
+  for (int i = 0; i < NZ; i++)
+    {
+      for (int j = 0; j < NY; j++)
+        {
+          for (int k = 0; k < NX; k++)
+            {
+              int index     = k + j * NX + i * NX * NY;
+              VOXELS[index] = (uint16_t)((k * k + j * 3 + i * 7) % 1021);
+            }
+        }
+    }
+}
+
+void
+writeFile (const char *filename, RVLenum compression)
+{
+  RVL *rvl = rvl_create_writer ();
+  rvl_set_volumetric_format (rvl, NX, NY, NZ, RVL_PRIMITIVE_U16,
+                             RVL_ENDIAN_LITTLE);
+  rvl_set_regular_grid (rvl, 1.0f, 1.0f, 1.0f);
+  rvl_set_compression (rvl, compression);
+  rvl_set_block_size (rvl, BLOCK_SIZE);
+  rvl_set_text (rvl, RVL_TEXT_TITLE, "Multi-block");
+  rvl_set_voxels (rvl, VOXELS);
+
+  rvl_set_file (rvl, filename);
+  rvl_write_rvl (rvl);
+  rvl_destroy (&rvl);
+}
+
+void
+checkReadRvl (const char *filename)
+{
+  RVL *rvl = rvl_create_reader ();
+  rvl_set_file (rvl, filename);
+  rvl_read_rvl (rvl);
+
+  if (memcmp (rvl_get_voxels (rvl), VOXELS, sizeof (VOXELS)) != 0)
+    {
+      exit (EXIT_FAILURE);
+    }
+
+  rvl_destroy (&rvl);
+}
+
+void
+checkReadVoxelsTo (const char *filename)
+{
+  RVL *rvl = rvl_create_reader ();
+  rvl_set_file (rvl, filename);
+  rvl_read_info (rvl);
+
+  // Read twice to check that the stream is rewound each time.
+  uint16_t *buffer = (uint16_t *)malloc (sizeof (VOXELS));
+  for (int n = 0; n < 2; n++)
+    {
+      memset (buffer, 0, sizeof (VOXELS));
+      rvl_read_voxels_to (rvl, buffer);
+
+      if (memcmp (buffer, VOXELS, sizeof (VOXELS)) != 0)
+        {
+          exit (EXIT_FAILURE);
+        }
+    }
+
+  free (buffer);
+  rvl_destroy (&rvl);
+}
+
+int
+main ()
+{
+  genVoxels ();
+
+  writeFile ("multi_block_lzma2.rvl", RVL_COMPRESSION_LZMA2);
+  checkReadRvl ("multi_block_lzma2.rvl");
+  checkReadVoxelsTo ("multi_block_lzma2.rvl");
+
+  writeFile ("multi_block_lz4.rvl", RVL_COMPRESSION_LZ4);
+  checkReadRvl ("multi_block_lz4.rvl");
+  checkReadVoxelsTo ("multi_block_lz4.rvl");
+}
@@ -0,0 +1,115 @@
+#include <rvl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NX 37
+#define NY 41
+#define NZ 43
+
+static uint16_t VOXELS[NX * NY * NZ];
+
+void
+genVoxels ()
+{
+  for (int i = 0; i < NX * NY * NZ; i++)
+    {
+      VOXELS[i] = (uint16_t)((i * 2654435761u) >> 13);
+    }
+}
+
+void
+writeFile (const char *filename, RVLenum compression)
+{
+  RVL *rvl = rvl_create_writer ();
+  rvl_set_volumetric_format (rvl, NX, NY, NZ, RVL_PRIMITIVE_U16,
+                             RVL_ENDIAN_LITTLE);
+  rvl_set_regular_grid (rvl, 1.0f, 1.0f, 1.0f);
+  rvl_set_compression (rvl, compression);
+  // Odd so that voxels and rows straddle the blocks
+  rvl_set_block_size (rvl, 3001);
+  rvl_set_voxels (rvl, VOXELS);
+
+  rvl_set_file (rvl, filename);
+  rvl_write_rvl (rvl);
+  rvl_destroy (&rvl);
+}
+
+void
+checkRegion (RVL *rvl, int x0, int y0, int z0, int nx, int ny, int nz)
+{
+  uint16_t *buffer = (uint16_t *)malloc (sizeof (uint16_t) * nx * ny * nz);
+  rvl_read_region (rvl, x0, y0, z0, nx, ny, nz, buffer);
+
+  const uint16_t *v = buffer;
+  for (int z = z0; z < z0 + nz; z++)
+    {
+      for (int y = y0; y < y0 + ny; y++)
+        {
+          for (int x = x0; x < x0 + nx; x++)
+            {
+              if (*v++ != VOXELS[x + y * NX + z * NX * NY])
+                {
+                  exit (EXIT_FAILURE);
+                }
+            }
+        }
+    }
+
+  free (buffer);
+}
+
+void
+checkRegions (RVL *rvl)
+{
+  checkRegion (rvl, 0, 0, 0, NX, NY, NZ);
+  checkRegion (rvl, 5, 7, 11, 13, 17, 19);
+  checkRegion (rvl, NX - 1, NY - 1, NZ - 1, 1, 1, 1);
+  checkRegion (rvl, 0, 20, 0, NX, 1, NZ);
+  checkRegion (rvl, 3, 0, 40, 1, NY, 3);
+}
+
+int
+main ()
+{
+  genVoxels ();
+
+  // Decompressed block by block through a small cache
+  writeFile ("read_region.rvl", RVL_COMPRESSION_LZMA2);
+  RVL *rvl = rvl_create_reader ();
+  rvl_set_file (rvl, "read_region.rvl");
+  rvl_read_info (rvl);
+  rvl_set_block_cache_size (rvl, 2);
+  checkRegions (rvl);
+
+  // The stream is left usable for the other readers.
+  uint16_t *buffer = (uint16_t *)malloc (sizeof (VOXELS));
+  rvl_read_voxels_to (rvl, buffer);
+  if (memcmp (buffer, VOXELS, sizeof (VOXELS)) != 0)
+    {
+      exit (EXIT_FAILURE);
+    }
+  free (buffer);
+  checkRegions (rvl);
+  rvl_destroy (&rvl);
+
+  // Copied from the voxels in memory
+  rvl = rvl_create_reader ();
+  rvl_set_file (rvl, "read_region.rvl");
+  rvl_read_rvl (rvl);
+  checkRegions (rvl);
+  rvl_destroy (&rvl);
+
+  // Stored blocks, read and mapped
+  writeFile ("read_region_stored.rvl", RVL_COMPRESSION_NONE);
+  rvl = rvl_create_reader ();
+  rvl_set_file (rvl, "read_region_stored.rvl");
+  rvl_read_info (rvl);
+  checkRegions (rvl);
+  if (rvl_map_voxels (rvl) == NULL)
+    {
+      exit (EXIT_FAILURE);
+    }
+  checkRegions (rvl);
+  rvl_destroy (&rvl);
+}
@@ -0,0 +1,194 @@
+#include <rvl.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NX 37
+#define NY 41
+#define NZ 43
+
+static uint16_t VOXELS[NX * NY * NZ];
+
+void
+genVoxels ()
+{
+  for (int i = 0; i < NX * NY * NZ; i++)
+    {
+      VOXELS[i] = (uint16_t)((i * 2654435761u) >> 13);
+    }
+}
+
+void
+writeFile (const char *filename, RVLenum compression)
+{
+  RVL *rvl = rvl_create_writer ();
+  rvl_set_volumetric_format (rvl, NX, NY, NZ, RVL_PRIMITIVE_U16,
+                             RVL_ENDIAN_LITTLE);
+  rvl_set_regular_grid (rvl, 1.0f, 1.0f, 1.0f);
+  rvl_set_compression (rvl, compression);
+  if (compression != RVL_COMPRESSION_NONE)
+    {
+      rvl_set_block_size (rvl, 3001);
+    }
+  rvl_set_voxels (rvl, VOXELS);
+
+  rvl_set_file (rvl, filename);
+  rvl_write_rvl (rvl);
+  rvl_destroy (&rvl);
+}
+
+// Flip a byte in the payload of the last DATA chunk, which is followed by its
+// CRC and the 12 bytes of the VEND chunk.
+void
+corruptFile (const char *filename)
+{
+  FILE *fp = fopen (filename, "r+b");
+  fseek (fp, -20, SEEK_END);
+  int c = fgetc (fp);
+  fseek (fp, -20, SEEK_END);
+  fputc (c ^ 0xff, fp);
+  fclose (fp);
+}
+
+// Cut off the end of the voxel data, but keep the chunk header that tells its
+// size.
+void
+truncateFile (const char *filename)
+{
+  FILE *fp = fopen (filename, "rb");
+  fseek (fp, 0, SEEK_END);
+  long  size = ftell (fp);
+  char *data = (char *)malloc (size);
+  fseek (fp, 0, SEEK_SET);
+  if (fread (data, 1, size, fp) != (size_t)size)
+    {
+      exit (EXIT_FAILURE);
+    }
+  fclose (fp);
+
+  fp = fopen (filename, "wb");
+  fwrite (data, 1, size - sizeof (VOXELS) / 2, fp);
+  fclose (fp);
+  free (data);
+}
+
+void
+writeGarbage (const char *filename)
+{
+  FILE *fp = fopen (filename, "wb");
+  fputs ("This is not a volumetric model.", fp);
+  fclose (fp);
+}
+
+// Each guarded call is in its own function, as the jump buffer is only valid
+// until the function that called setjmp returns.
+int
+tryReadInfo (RVL *rvl)
+{
+  if (setjmp (*rvl_error_jmpbuf (rvl)) != 0)
+    {
+      return 0;
+    }
+  rvl_read_info (rvl);
+  return 1;
+}
+
+int
+tryReadVoxels (RVL *rvl, void *buffer)
+{
+  if (setjmp (*rvl_error_jmpbuf (rvl)) != 0)
+    {
+      return 0;
+    }
+  rvl_read_voxels_to (rvl, buffer);
+  return 1;
+}
+
+int
+tryMapVoxels (RVL *rvl)
+{
+  if (setjmp (*rvl_error_jmpbuf (rvl)) != 0)
+    {
+      return 0;
+    }
+  return rvl_map_voxels (rvl) != NULL;
+}
+
+int
+tryReadRegion (RVL *rvl, int z0, int nz, void *buffer)
+{
+  if (setjmp (*rvl_error_jmpbuf (rvl)) != 0)
+    {
+      return 0;
+    }
+  rvl_read_region (rvl, 0, 0, z0, NX, NY, nz, buffer);
+  return 1;
+}
+
+void
+expectError (RVL *rvl, int succeeded)
+{
+  if (succeeded || strlen (rvl_get_error (rvl)) == 0)
+    {
+      exit (EXIT_FAILURE);
+    }
+}
+
+int
+main ()
+{
+  genVoxels ();
+  writeFile ("recover_error.rvl", RVL_COMPRESSION_LZ4);
+  writeFile ("recover_error_corrupt.rvl", RVL_COMPRESSION_LZ4);
+  corruptFile ("recover_error_corrupt.rvl");
+  writeFile ("recover_error_truncated.rvl", RVL_COMPRESSION_NONE);
+  writeGarbage ("recover_error_garbage.rvl");
+
+  uint16_t *buffer = (uint16_t *)malloc (sizeof (VOXELS));
+  RVL      *rvl    = rvl_create_reader ();
+
+  rvl_set_file (rvl, "recover_error_missing.rvl");
+  expectError (rvl, tryReadInfo (rvl));
+
+  rvl_set_file (rvl, "recover_error_garbage.rvl");
+  expectError (rvl, tryReadInfo (rvl));
+
+  // The buffer is the caller's and must survive the error and rvl_destroy.
+  rvl_set_file (rvl, "recover_error_corrupt.rvl");
+  if (!tryReadInfo (rvl))
+    {
+      exit (EXIT_FAILURE);
+    }
+  expectError (rvl, tryReadVoxels (rvl, buffer));
+
+  // Only the last block is broken, so a region before it can still be read.
+  expectError (rvl, tryReadRegion (rvl, NZ - 1, 1, buffer));
+  if (!tryReadRegion (rvl, 0, 1, buffer)
+      || memcmp (buffer, VOXELS, sizeof (uint16_t) * NX * NY) != 0)
+    {
+      exit (EXIT_FAILURE);
+    }
+
+  // Mapping the data of a file that was truncated after its information was
+  // read would fault on the first access.
+  rvl_set_file (rvl, "recover_error_truncated.rvl");
+  if (!tryReadInfo (rvl))
+    {
+      exit (EXIT_FAILURE);
+    }
+  truncateFile ("recover_error_truncated.rvl");
+  expectError (rvl, tryMapVoxels (rvl));
+
+  // The instance can still read another file.
+  rvl_set_file (rvl, "recover_error.rvl");
+  if (!tryReadInfo (rvl) || !tryReadVoxels (rvl, buffer)
+      || memcmp (buffer, VOXELS, sizeof (VOXELS)) != 0)
+    {
+      exit (EXIT_FAILURE);
+    }
+
+  rvl_destroy (&rvl);
+  free (buffer);
+}
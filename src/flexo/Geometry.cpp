@@ -8,7 +8,7 @@ namespace geom
     {
     }
 
-    glm::vec3 Edge::ClosestPointTo(glm::vec3 point)
+    glm::vec3 Edge::ClosestPointTo(glm::vec3 point) const
     {
         using glm::dot;
 
@@ -40,7 +40,7 @@ namespace geom
         normal = glm::normalize(glm::cross(B - A, C - A));
     }
 
-    glm::vec3 Triangle::ClosestPointTo(glm::vec3 point)
+    glm::vec3 Triangle::ClosestPointTo(glm::vec3 point) const
     {
         using glm::dot;
 
@@ -59,7 +59,7 @@ namespace geom
         return P;
     }
 
-    glm::vec3 Triangle::BarycentricCoordinates(glm::vec3 point)
+    glm::vec3 Triangle::BarycentricCoordinates(glm::vec3 point) const
     {
         using glm::dot, glm::cross;
 
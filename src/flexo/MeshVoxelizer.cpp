@@ -0,0 +1,297 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "MeshVoxelizer.hpp"
+
+namespace
+{
+    unsigned char const ModelValue = 255;
+
+    // Slices voxelized by one task. Triangles that cross several slabs are tested in each of them.
+    int const SlabDepth = 8;
+
+    struct Triangle {
+        glm::vec3 v[3];
+    };
+
+    /**
+     * Separating axis test between a triangle and unit voxels, after Akenine-Möller
+     *
+     * Everything that depends only on the triangle is computed once, since it is tested against every voxel of its
+     * bounding box. The box axes need no test because only voxels in the bounding box are ever passed.
+     */
+    class TriangleBoxTest
+    {
+    public:
+        explicit TriangleBoxTest(Triangle const& tri)
+            : m_tri(tri)
+            , m_normal(glm::cross(tri.v[1] - tri.v[0], tri.v[2] - tri.v[1]))
+        {
+            glm::vec3 const edges[3] = { tri.v[1] - tri.v[0], tri.v[2] - tri.v[1], tri.v[0] - tri.v[2] };
+            for (int i = 0; i < 3; i++) {
+                m_axes[3 * i + 0] = glm::vec3(0.0f, -edges[i].z, edges[i].y); // X cross edge
+                m_axes[3 * i + 1] = glm::vec3(edges[i].z, 0.0f, -edges[i].x); // Y cross edge
+                m_axes[3 * i + 2] = glm::vec3(-edges[i].y, edges[i].x, 0.0f); // Z cross edge
+            }
+        }
+
+        bool Overlaps(glm::vec3 const& boxCenter) const
+        {
+            float const half = 0.5f;
+            glm::vec3 const v0 = m_tri.v[0] - boxCenter;
+            glm::vec3 const v1 = m_tri.v[1] - boxCenter;
+            glm::vec3 const v2 = m_tri.v[2] - boxCenter;
+
+            for (glm::vec3 const& axis : m_axes) {
+                float const p0 = glm::dot(axis, v0);
+                float const p1 = glm::dot(axis, v1);
+                float const p2 = glm::dot(axis, v2);
+                float const radius = half * (std::abs(axis.x) + std::abs(axis.y) + std::abs(axis.z));
+                if (std::min({ p0, p1, p2 }) > radius || std::max({ p0, p1, p2 }) < -radius) {
+                    return false;
+                }
+            }
+
+            // The plane of the triangle separates the box if the projection of the box on the normal does not reach it.
+            float const distance = glm::dot(m_normal, v0);
+            float const radius = half * (std::abs(m_normal.x) + std::abs(m_normal.y) + std::abs(m_normal.z));
+            return std::abs(distance) <= radius;
+        }
+
+    private:
+        Triangle m_tri;
+        glm::vec3 m_normal;
+        glm::vec3 m_axes[9];
+    };
+
+    /**
+     * Where the ray along X through (y, z) crosses a triangle, if it does
+     *
+     * Points on an edge shared by two triangles belong to exactly one of them, so a ray through the edge is counted
+     * once and the parity stays right.
+     */
+    bool IntersectRayX(Triangle const& tri, double y, double z, double& x)
+    {
+        glm::dvec3 a(tri.v[0]);
+        glm::dvec3 b(tri.v[1]);
+        glm::dvec3 c(tri.v[2]);
+
+        double area = (b.y - a.y) * (c.z - a.z) - (b.z - a.z) * (c.y - a.y);
+        if (area == 0.0) {
+            return false;
+        }
+        if (area < 0.0) {
+            std::swap(b, c);
+        }
+
+        // The edges are counter-clockwise in the YZ plane. An edge owns the points on it if it runs in -Z, or in +Y.
+        auto const inside = [y, z](glm::dvec3 const& p0, glm::dvec3 const& p1) {
+            double const dy = p1.y - p0.y;
+            double const dz = p1.z - p0.z;
+            double const e = dy * (z - p0.z) - dz * (y - p0.y);
+            return e > 0.0 || (e == 0.0 && (dz < 0.0 || (dz == 0.0 && dy > 0.0)));
+        };
+        if (!inside(a, b) || !inside(b, c) || !inside(c, a)) {
+            return false;
+        }
+
+        glm::dvec3 const n = glm::cross(b - a, c - a);
+        x = a.x - (n.y * (y - a.y) + n.z * (z - a.z)) / n.x;
+        return true;
+    }
+
+    void VoxelizeSurface(Triangle const& tri, glm::ivec3 const& n, int z0, int z1, unsigned char* voxels)
+    {
+        glm::vec3 const lo = glm::min(glm::min(tri.v[0], tri.v[1]), tri.v[2]);
+        glm::vec3 const hi = glm::max(glm::max(tri.v[0], tri.v[1]), tri.v[2]);
+        glm::ivec3 const first = glm::clamp(glm::ivec3(glm::floor(lo)), glm::ivec3(0), n - 1);
+        glm::ivec3 const last = glm::clamp(glm::ivec3(glm::floor(hi)), glm::ivec3(0), n - 1);
+
+        TriangleBoxTest const test(tri);
+        for (int z = std::max(first.z, z0); z <= std::min(last.z, z1 - 1); z++) {
+            for (int y = first.y; y <= last.y; y++) {
+                std::size_t const row = (static_cast<std::size_t>(z) * n.y + y) * n.x;
+                for (int x = first.x; x <= last.x; x++) {
+                    if (voxels[row + x] != ModelValue && test.Overlaps(glm::vec3(x, y, z) + 0.5f)) {
+                        voxels[row + x] = ModelValue;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Fill the voxels between every pair of crossings on the rows of slices z0 to z1
+     *
+     * An unmatched last crossing, which only happens if the mesh is not closed, is ignored.
+     */
+    void FillSlab(std::vector<Triangle> const& triangles, std::vector<unsigned int> const& bin, glm::ivec3 const& n,
+                  int z0, int z1, unsigned char* voxels)
+    {
+        std::vector<std::vector<double>> crossings(static_cast<std::size_t>(z1 - z0) * n.y);
+
+        for (unsigned int t : bin) {
+            Triangle const& tri = triangles[t];
+            float const yMin = std::min({ tri.v[0].y, tri.v[1].y, tri.v[2].y });
+            float const yMax = std::max({ tri.v[0].y, tri.v[1].y, tri.v[2].y });
+            float const zMin = std::min({ tri.v[0].z, tri.v[1].z, tri.v[2].z });
+            float const zMax = std::max({ tri.v[0].z, tri.v[1].z, tri.v[2].z });
+
+            // Rows whose centre lies in the bounding box of the triangle
+            int const yFirst = std::max(0, static_cast<int>(std::ceil(yMin - 0.5f)));
+            int const yLast = std::min(n.y - 1, static_cast<int>(std::floor(yMax - 0.5f)));
+            int const zFirst = std::max(z0, static_cast<int>(std::ceil(zMin - 0.5f)));
+            int const zLast = std::min(z1 - 1, static_cast<int>(std::floor(zMax - 0.5f)));
+
+            for (int z = zFirst; z <= zLast; z++) {
+                for (int y = yFirst; y <= yLast; y++) {
+                    double x;
+                    if (IntersectRayX(tri, y + 0.5, z + 0.5, x)) {
+                        crossings[static_cast<std::size_t>(z - z0) * n.y + y].push_back(x);
+                    }
+                }
+            }
+        }
+
+        for (int z = z0; z < z1; z++) {
+            for (int y = 0; y < n.y; y++) {
+                auto& xs = crossings[static_cast<std::size_t>(z - z0) * n.y + y];
+                std::sort(xs.begin(), xs.end());
+                std::size_t const row = (static_cast<std::size_t>(z) * n.y + y) * n.x;
+                for (std::size_t i = 0; i + 1 < xs.size(); i += 2) {
+                    int const first = std::max(0, static_cast<int>(std::ceil(xs[i] - 0.5)));
+                    int const last = std::min(n.x - 1, static_cast<int>(std::floor(xs[i + 1] - 0.5)));
+                    if (first <= last) {
+                        std::fill(voxels + row + first, voxels + row + last + 1, ModelValue);
+                    }
+                }
+            }
+        }
+    }
+}
+
+VoxelGrid::VoxelGrid(glm::ivec3 resolution, glm::vec3 voxelDims, glm::vec3 origin)
+    : m_resolution(resolution)
+    , m_vxDims(voxelDims)
+    , m_origin(origin)
+    , m_voxels(new unsigned char[static_cast<std::size_t>(resolution.x) * resolution.y * resolution.z])
+{
+}
+
+unsigned char* VoxelGrid::GetBuffer()
+{
+    return m_voxels.get();
+}
+
+unsigned char const* VoxelGrid::GetBuffer() const
+{
+    return m_voxels.get();
+}
+
+unsigned char const* VoxelGrid::GetSlice(int z, unsigned char*) const
+{
+    return m_voxels.get() + static_cast<std::size_t>(z) * m_resolution.x * m_resolution.y;
+}
+
+glm::ivec3 VoxelGrid::GetResolution() const
+{
+    return m_resolution;
+}
+
+glm::vec3 VoxelGrid::GetVoxelDims() const
+{
+    return m_vxDims;
+}
+
+glm::vec3 VoxelGrid::GetGridOrigin() const
+{
+    return m_origin;
+}
+
+std::unique_ptr<VoxelGrid> VoxelizeMesh(Mesh const& mesh, int resolution, bool solid,
+                                        VoxelizeProgress const& progress)
+{
+    if (mesh.positions.empty() || resolution <= 0) {
+        return std::make_unique<VoxelGrid>(glm::ivec3(0), glm::vec3(1.0f), glm::vec3(0.0f));
+    }
+
+    glm::vec3 lo = mesh.positions.front();
+    glm::vec3 hi = lo;
+    for (auto const& p : mesh.positions) {
+        lo = glm::min(lo, p);
+        hi = glm::max(hi, p);
+    }
+
+    glm::vec3 const extent = hi - lo;
+    float const size = std::max({ extent.x, extent.y, extent.z, 1e-6f }) / static_cast<float>(resolution);
+    glm::ivec3 const n = glm::max(glm::ivec3(glm::ceil(extent / size)), glm::ivec3(1));
+
+    // Triangles in grid coordinates, where voxel (x, y, z) spans [x, x + 1] and so on
+    int const count = mesh.HasFaces() ? mesh.faces.size() : mesh.positions.size() / 3;
+    std::vector<Triangle> triangles(count);
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < count; i++) {
+        for (int k = 0; k < 3; k++) {
+            unsigned int const index = mesh.HasFaces() ? mesh.faces[i][k] : 3 * i + k;
+            triangles[i].v[k] = (mesh.positions[index] - lo) / size;
+        }
+    }
+
+    int const slabCount = (n.z + SlabDepth - 1) / SlabDepth;
+    auto const slabRange = [&n](Triangle const& tri) {
+        float const zMin = std::min({ tri.v[0].z, tri.v[1].z, tri.v[2].z });
+        float const zMax = std::max({ tri.v[0].z, tri.v[1].z, tri.v[2].z });
+        int const first = std::clamp(static_cast<int>(std::floor(zMin)), 0, n.z - 1) / SlabDepth;
+        int const last = std::clamp(static_cast<int>(std::floor(zMax)), 0, n.z - 1) / SlabDepth;
+        return std::make_pair(first, last);
+    };
+
+    std::vector<std::vector<unsigned int>> bins(slabCount);
+    for (int i = 0; i < count; i++) {
+        auto const [first, last] = slabRange(triangles[i]);
+        for (int s = first; s <= last; s++) {
+            bins[s].push_back(i);
+        }
+    }
+
+    if (progress && !progress(0.0f)) {
+        return nullptr;
+    }
+
+    // Every slab clears and writes only its own slices. Once stopped, the remaining slabs are skipped.
+    auto grid = std::make_unique<VoxelGrid>(n, glm::vec3(size), lo);
+    unsigned char* voxels = grid->GetBuffer();
+    std::size_t const sliceSize = static_cast<std::size_t>(n.x) * n.y;
+    std::atomic<bool> stopped(false);
+    int slabsDone = 0;
+#pragma omp parallel for schedule(dynamic)
+    for (int s = 0; s < slabCount; s++) {
+        if (stopped) {
+            continue;
+        }
+        int const z0 = s * SlabDepth;
+        int const z1 = std::min(z0 + SlabDepth, n.z);
+        std::fill(voxels + z0 * sliceSize, voxels + z1 * sliceSize, 0);
+        if (solid) {
+            FillSlab(triangles, bins[s], n, z0, z1, voxels);
+        }
+        for (unsigned int t : bins[s]) {
+            VoxelizeSurface(triangles[t], n, z0, z1, voxels);
+        }
+        if (progress) {
+#pragma omp critical
+            if (!progress(100.0f * ++slabsDone / slabCount)) {
+                stopped = true;
+            }
+        }
+    }
+
+    if (stopped) {
+        return nullptr;
+    }
+    return grid;
+}
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+#include "MeshVoxelizer.hpp"
+#include "ModelImport.hpp"
+#include "SurfaceExtractor.hpp"
+#include "VolumetricModelData.hpp"
+#include "assetlib/OBJ/OBJImporter.hpp"
+#include "assetlib/STL/STLImporter.hpp"
+#include "log/Logger.h"
+
+namespace
+{
+    // Where each step ends, in percent of the whole import. Reading a volume is part of the extraction.
+    float const MeshReadEnd = 30.0f;
+    float const VoxelizeEnd = 50.0f;
+    float const ExtractEnd = 90.0f;
+}
+
+ModelImport::ModelImport(std::string filename, int resolution, bool solid)
+    : m_filename(std::move(filename))
+    , m_resolution(resolution)
+    , m_solid(solid)
+    , m_cancel(false)
+    , m_progress(0.0f)
+{
+    m_task = std::async(std::launch::async, &ModelImport::Run, this);
+}
+
+ModelImport::~ModelImport()
+{
+    Cancel();
+    m_task.wait();
+}
+
+void ModelImport::Cancel()
+{
+    m_cancel = true;
+}
+
+bool ModelImport::WaitFor(std::chrono::milliseconds timeout) const
+{
+    return m_task.wait_for(timeout) == std::future_status::ready;
+}
+
+float ModelImport::GetProgress() const
+{
+    return m_progress;
+}
+
+std::shared_ptr<SurfaceVoxels> ModelImport::GetResult()
+{
+    m_task.wait();
+    return m_result;
+}
+
+std::string const& ModelImport::GetError() const
+{
+    return m_error;
+}
+
+void ModelImport::Run()
+{
+    std::string ext = std::filesystem::path(m_filename).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    std::unique_ptr<VoxelSliceSource> source;
+    VolumetricModelData const* volume = nullptr;
+    float extractStart = 0.0f;
+
+    if (ext == ".stl" || ext == ".obj") {
+        std::unique_ptr<BaseImporter> importer;
+        if (ext == ".stl") {
+            importer = std::make_unique<STLImporter>();
+        } else {
+            importer = std::make_unique<OBJImporter>();
+        }
+
+        Mesh const mesh = importer->ReadFile(m_filename);
+        if (!importer->GetError().empty()) {
+            m_error = importer->GetError();
+            return;
+        }
+        if (mesh.positions.empty()) {
+            m_error = "\"" + m_filename + "\" has no triangles";
+            return;
+        }
+        m_progress = MeshReadEnd;
+
+        if (m_cancel) {
+            return;
+        }
+
+        auto grid = VoxelizeMesh(mesh, m_resolution, m_solid, [this](float percent) {
+            m_progress = MeshReadEnd + (VoxelizeEnd - MeshReadEnd) * percent / 100.0f;
+            return !m_cancel;
+        });
+        if (!grid) {
+            return;
+        }
+        glm::ivec3 const res = grid->GetResolution();
+        log_info("Voxelized \"%s\" into %dx%dx%d voxels", m_filename.c_str(), res.x, res.y, res.z);
+        source = std::move(grid);
+        m_progress = extractStart = VoxelizeEnd;
+    } else {
+        auto data = std::make_unique<VolumetricModelData>();
+        if (!data->Open(m_filename)) {
+            m_error = data->GetError();
+            return;
+        }
+        volume = data.get();
+        source = std::move(data);
+    }
+
+    if (m_cancel) {
+        return;
+    }
+
+    // A slice that cannot be decompressed stops the extraction, since the surface would have a hole there.
+    std::vector<Voxel> voxels;
+    bool const done = ExtractSurfaceVoxels(
+        *source, [&voxels](Voxel const& vx) { voxels.push_back(vx); },
+        [this, volume, extractStart](float percent) {
+            m_progress = extractStart + (ExtractEnd - extractStart) * percent / 100.0f;
+            return !m_cancel && (volume == nullptr || volume->GetError().empty());
+        });
+
+    if (volume != nullptr && !volume->GetError().empty()) {
+        m_error = volume->GetError();
+        return;
+    }
+    if (!done) {
+        return;
+    }
+
+    glm::vec3 const scale = source->GetVoxelDims();
+    source.reset();
+
+    auto model = std::make_shared<SurfaceVoxels>(std::move(voxels), scale);
+    bool const built = model->GenerateMesh([this](float percent) {
+        m_progress = ExtractEnd + (100.0f - ExtractEnd) * percent / 100.0f;
+        return !m_cancel;
+    });
+    if (!built) {
+        return;
+    }
+
+    m_result = std::move(model);
+    m_progress = 100.0f;
+}
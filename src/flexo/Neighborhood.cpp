@@ -20,3 +20,40 @@ Neighborhood::Neighborhood(NeighborhoodRadius radius)
     : radius(radius)
 {
 }
+
+NeighborhoodKernel::NeighborhoodKernel()
+    : radius(0)
+    , rate(0.0f)
+    , taps()
+    , spans()
+{
+}
+
+void NeighborhoodKernel::Evaluate(Neighborhood const& neighborhood, LearningRate const& learnRate, int t)
+{
+    float const r = neighborhood.radius(t);
+    radius = (r >= 1.0f) ? static_cast<int>(r) : 0;
+    rate = learnRate(t);
+
+    // The radius reaches 0 at the last step, where the gaussian would be 0 / 0 at the centre. It is 1 there for any
+    // radius, so a neighborhood of no size leaves every node to its own samples.
+    taps.resize(2 * radius + 1);
+    taps[radius] = 1.0f;
+    for (int k = 1; k <= radius; k++) {
+        float const g = expf(-static_cast<float>(k * k) / (2.0f * (r * r)));
+        taps[radius + k] = g;
+        taps[radius - k] = g;
+    }
+
+    // Integer square roots, so that the neighborhood is exactly the same disk on every platform.
+    spans.resize(radius);
+    int const radSqr = radius * radius;
+    int span = radius;
+    for (int dy = 0; dy < radius; dy++) {
+        int const remains = radSqr - dy * dy;
+        while (span * span >= remains) {
+            span--;
+        }
+        spans[dy] = span;
+    }
+}
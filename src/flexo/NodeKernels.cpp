@@ -0,0 +1,255 @@
+#include <limits>
+
+#include "NodeKernels.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define NODE_KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_AVX2
+#endif
+
+namespace
+{
+    using FindNearestFn = unsigned int (*)(float const* const*, int, unsigned int, float const*);
+    using AttractFn = void (*)(float* const*, int, unsigned int, float const*, float const*);
+
+    struct Implementation {
+        char const* name;
+        FindNearestFn findNearest;
+        AttractFn attract;
+    };
+
+    /**
+     * Scan nodes [first, count) and update the running minimum.
+     */
+    void FindNearestTail(float const* const* weights, int dims, unsigned int first, unsigned int count,
+                         float const* input, float& distMin, unsigned int& nearest)
+    {
+        for (unsigned int i = first; i < count; i++) {
+            float dist = 0.0f;
+            for (int d = 0; d < dims; d++) {
+                float const diff = input[d] - weights[d][i];
+                dist += diff * diff;
+            }
+            if (dist < distMin) {
+                distMin = dist;
+                nearest = i;
+            }
+        }
+    }
+
+    void AttractTail(float* const* weights, int dims, unsigned int first, unsigned int count, float const* rates,
+                     float const* input)
+    {
+        for (int d = 0; d < dims; d++) {
+            float* w = weights[d];
+            for (unsigned int i = first; i < count; i++) {
+                w[i] += rates[i] * (input[d] - w[i]);
+            }
+        }
+    }
+
+    /**
+     * Reduce the per-lane minimums of a vector kernel, preferring the lower index on ties.
+     */
+    void ReduceLanes(float const* dist, unsigned int const* index, int lanes, float& distMin, unsigned int& nearest)
+    {
+        for (int l = 0; l < lanes; l++) {
+            if (dist[l] < distMin || (dist[l] == distMin && index[l] < nearest)) {
+                distMin = dist[l];
+                nearest = index[l];
+            }
+        }
+    }
+
+    unsigned int FindNearestScalar(float const* const* weights, int dims, unsigned int count, float const* input)
+    {
+        float distMin = std::numeric_limits<float>::max();
+        unsigned int nearest = 0;
+        FindNearestTail(weights, dims, 0, count, input, distMin, nearest);
+        return nearest;
+    }
+
+    void AttractScalar(float* const* weights, int dims, unsigned int count, float const* rates, float const* input)
+    {
+        AttractTail(weights, dims, 0, count, rates, input);
+    }
+
+#ifdef NODE_KERNELS_X86
+    TARGET_SSE2 unsigned int FindNearestSSE2(float const* const* weights, int dims, unsigned int count,
+                                             float const* input)
+    {
+        __m128 best = _mm_set1_ps(std::numeric_limits<float>::max());
+        __m128i bestIndex = _mm_setzero_si128();
+        __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+        __m128i const step = _mm_set1_epi32(4);
+
+        unsigned int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128 dist = _mm_setzero_ps();
+            for (int d = 0; d < dims; d++) {
+                __m128 const diff = _mm_sub_ps(_mm_set1_ps(input[d]), _mm_loadu_ps(weights[d] + i));
+                dist = _mm_add_ps(dist, _mm_mul_ps(diff, diff));
+            }
+            __m128 const closer = _mm_cmplt_ps(dist, best);
+            __m128i const closerIndex = _mm_castps_si128(closer);
+            best = _mm_or_ps(_mm_and_ps(closer, dist), _mm_andnot_ps(closer, best));
+            bestIndex = _mm_or_si128(_mm_and_si128(closerIndex, index), _mm_andnot_si128(closerIndex, bestIndex));
+            index = _mm_add_epi32(index, step);
+        }
+
+        alignas(16) float laneDist[4];
+        alignas(16) unsigned int laneIndex[4];
+        _mm_store_ps(laneDist, best);
+        _mm_store_si128(reinterpret_cast<__m128i*>(laneIndex), bestIndex);
+
+        float distMin = std::numeric_limits<float>::max();
+        unsigned int nearest = 0;
+        ReduceLanes(laneDist, laneIndex, 4, distMin, nearest);
+        FindNearestTail(weights, dims, i, count, input, distMin, nearest);
+        return nearest;
+    }
+
+    TARGET_SSE2 void AttractSSE2(float* const* weights, int dims, unsigned int count, float const* rates,
+                                 float const* input)
+    {
+        unsigned int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128 const rate = _mm_loadu_ps(rates + i);
+            for (int d = 0; d < dims; d++) {
+                __m128 w = _mm_loadu_ps(weights[d] + i);
+                w = _mm_add_ps(w, _mm_mul_ps(rate, _mm_sub_ps(_mm_set1_ps(input[d]), w)));
+                _mm_storeu_ps(weights[d] + i, w);
+            }
+        }
+        AttractTail(weights, dims, i, count, rates, input);
+    }
+
+    TARGET_AVX2 unsigned int FindNearestAVX2(float const* const* weights, int dims, unsigned int count,
+                                             float const* input)
+    {
+        __m256 best = _mm256_set1_ps(std::numeric_limits<float>::max());
+        __m256i bestIndex = _mm256_setzero_si256();
+        __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        __m256i const step = _mm256_set1_epi32(8);
+
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 dist = _mm256_setzero_ps();
+            for (int d = 0; d < dims; d++) {
+                __m256 const diff = _mm256_sub_ps(_mm256_set1_ps(input[d]), _mm256_loadu_ps(weights[d] + i));
+                dist = _mm256_add_ps(dist, _mm256_mul_ps(diff, diff));
+            }
+            __m256 const closer = _mm256_cmp_ps(dist, best, _CMP_LT_OQ);
+            best = _mm256_blendv_ps(best, dist, closer);
+            bestIndex = _mm256_castps_si256(
+                _mm256_blendv_ps(_mm256_castsi256_ps(bestIndex), _mm256_castsi256_ps(index), closer));
+            index = _mm256_add_epi32(index, step);
+        }
+
+        alignas(32) float laneDist[8];
+        alignas(32) unsigned int laneIndex[8];
+        _mm256_store_ps(laneDist, best);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(laneIndex), bestIndex);
+
+        float distMin = std::numeric_limits<float>::max();
+        unsigned int nearest = 0;
+        ReduceLanes(laneDist, laneIndex, 8, distMin, nearest);
+        FindNearestTail(weights, dims, i, count, input, distMin, nearest);
+        return nearest;
+    }
+
+    TARGET_AVX2 void AttractAVX2(float* const* weights, int dims, unsigned int count, float const* rates,
+                                 float const* input)
+    {
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 const rate = _mm256_loadu_ps(rates + i);
+            for (int d = 0; d < dims; d++) {
+                __m256 w = _mm256_loadu_ps(weights[d] + i);
+                w = _mm256_add_ps(w, _mm256_mul_ps(rate, _mm256_sub_ps(_mm256_set1_ps(input[d]), w)));
+                _mm256_storeu_ps(weights[d] + i, w);
+            }
+        }
+        AttractTail(weights, dims, i, count, rates, input);
+    }
+
+    bool HasSSE2()
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        return info[3] & (1 << 26);
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse2");
+#endif
+    }
+
+    bool HasAVX2()
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) {
+            return false;
+        }
+        __cpuid(info, 1);
+        bool const osxsave = info[2] & (1 << 27);
+        bool const avx = info[2] & (1 << 28);
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return info[1] & (1 << 5);
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+
+    Implementation const& Select()
+    {
+        static Implementation const impl = [] {
+#ifdef NODE_KERNELS_X86
+            if (HasAVX2()) {
+                return Implementation { "AVX2", FindNearestAVX2, AttractAVX2 };
+            }
+            if (HasSSE2()) {
+                return Implementation { "SSE2", FindNearestSSE2, AttractSSE2 };
+            }
+#endif
+            return Implementation { "Scalar", FindNearestScalar, AttractScalar };
+        }();
+        return impl;
+    }
+}
+
+namespace kernel
+{
+    char const* InstructionSet()
+    {
+        return Select().name;
+    }
+
+    unsigned int FindNearest(float const* const* weights, int dims, unsigned int count, float const* input)
+    {
+        return Select().findNearest(weights, dims, count, input);
+    }
+
+    void Attract(float* const* weights, int dims, unsigned int count, float const* rates, float const* input)
+    {
+        Select().attract(weights, dims, count, rates, input);
+    }
+}
@@ -184,7 +184,8 @@ void ProjectWindow::OnOpenModelFile(wxCommandEvent&)
     namespace fs = std::filesystem;
     static wxString defaultDir = "";
 
-    wxFileDialog dialog(this, "Import Input Dataset", defaultDir, "", "Volumetric model (.rvl)|*.rvl",
+    wxFileDialog dialog(this, "Import Input Dataset", defaultDir, "",
+                        "Volumetric model (.rvl)|*.rvl|Mesh (.stl, .obj)|*.stl;*.obj",
                         wxFD_OPEN | wxFD_FILE_MUST_EXIST);
     dialog.CenterOnParent();
 
@@ -4,7 +4,6 @@
 #include <string>
 
 #include "Project.hpp"
-#include "RandomRealNumber.hpp"
 #include "Scene.hpp"
 #include "gfx/Renderer.hpp"
 #include "object/SurfaceVoxels.hpp"
@@ -14,8 +13,6 @@
 #include "pane/SelfOrganizingMapPane.hpp"
 #include "ResourcePath.hpp"
 
-constexpr auto PI = 3.14159265358979323846;
-
 #define X(type, name) name,
 static std::string ObjectTypeNames[] = { OBJECT_TYPES };
 #undef X
@@ -71,69 +68,22 @@ void Scene::AddTorus(int majorSeg, int minorSeg, float majorRad, float minorRad)
     AcceptObject(obj);
 }
 
-void Scene::AddMap(int width, int height, MapFlags flags, MapInitState initState)
+void Scene::AddMap(int width, int height, MapFlags flags, MapInitState initState, std::uint64_t seed)
 {
-    auto map = std::make_shared<Map<3, 2>>();
-
-    float const w = static_cast<float>(width - 1);
-    float const h = static_cast<float>(height - 1);
-
-    switch (initState) {
-    default:
-    case MapInitState_Random: {
-        BoundingBox box = { { 5.0f, 5.0f, 5.0f }, { -5.0f, -5.0f, -5.0f } };
-        RandomRealNumber<float> xRng(box.min.x, box.max.x);
-        RandomRealNumber<float> yRng(box.min.y, box.max.y);
-        RandomRealNumber<float> zRng(box.min.z, box.max.z);
-
-        for (int j = 0; j < height; ++j) {
-            for (int i = 0; i < width; ++i) {
-                map->nodes.emplace_back(Vec3f { xRng.scalar(), yRng.scalar(), zRng.scalar() },
-                                        Vec2f { static_cast<float>(i), static_cast<float>(j) }, Vec2f { i / w, j / h });
-            }
-        }
-    } break;
-    case MapInitState_Plane: {
-        float dx = 2.0f / static_cast<float>(width - 1);
-        float dy = 2.0f / static_cast<float>(height - 1);
-
-        for (int j = 0; j < height; ++j) {
-            for (int i = 0; i < width; ++i) {
-                map->nodes.emplace_back(Vec3f { -1.0f + i * dx, -1.0f + j * dy, 0.005f },
-                                        Vec2f { static_cast<float>(i), static_cast<float>(j) }, Vec2f { i / w, j / h });
-            }
-        }
-    } break;
-    case MapInitState_Cylinder: {
-        float dr = glm::radians(360.0f) / static_cast<float>(width - 1);
-        float dz = 2.0f * PI * 1.0f / static_cast<float>(height - 1);
-
-        for (int j = 0; j < height; ++j) {
-            for (int i = 0; i < width; ++i) {
-                auto rad = i * dr;
-                map->nodes.emplace_back(Vec3f { cos(rad), sin(rad), j * dz },
-                                        Vec2f { static_cast<float>(i), static_cast<float>(j) }, Vec2f { i / w, j / h });
-            }
-        }
-    } break;
-    }
+    auto map = ConstructMap(width, height, flags, initState, seed);
 
     auto& gfx = SceneViewportPane::Get(m_project).GetGL();
 
-    map->size.x = width;
-    map->size.y = height;
-    map->flags = flags;
     map->GenerateDrawables(gfx);
     map->SetTexture(Bind::TextureManager::Resolve(gfx, ResourcePath::GetImageFile("blank.png"), 0));
     map->SetViewFlags(ObjectViewFlag_TexturedWithWireframe);
     AcceptObject(map);
 }
 
-void Scene::AddModel(VolumetricModelData const& data)
+void Scene::AddModel(std::shared_ptr<SurfaceVoxels> model)
 {
-    auto obj = std::make_shared<SurfaceVoxels>(data);
-    AcceptObject(obj);
-    log_info("%lu voxels will be rendered.", obj->Voxels().size());
+    AcceptObject(model);
+    log_info("%lu voxels will be rendered.", model->Voxels().size());
 }
 
 std::weak_ptr<Object> Scene::GetObject(std::string const& id) const
@@ -1,12 +1,19 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <random>
+
 #include <wx/event.h>
+#include <wx/progdlg.h>
 #include <wx/valnum.h>
 
 #include "Dataset.hpp"
+#include "ModelImport.hpp"
 #include "Project.hpp"
 #include "ProjectWindow.hpp"
 #include "Scene.hpp"
 #include "SceneController.hpp"
-#include "VolumetricModelData.hpp"
 #include "dialog/AddDialog.hpp"
 #include "gfx/bindable/TextureManager.hpp"
 #include "object/Object.hpp"
@@ -79,9 +86,57 @@ std::vector<std::string> SceneController::GetAllMapsByID() const
 
 void SceneController::OnImportModel(wxCommandEvent& event)
 {
-    VolumetricModelData data;
-    data.Read(event.GetString().ToStdString().c_str());
-    Scene::Get(m_project).AddModel(data);
+    std::string const filename = event.GetString().ToStdString();
+    std::string ext = std::filesystem::path(filename).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    long resolution = 128;
+    bool solid = true;
+
+    // Meshes are voxelized first, at a resolution that only the user can pick.
+    if (ext == ".stl" || ext == ".obj") {
+        AddDialog dlg(m_project.GetWindow(), "Voxelize Mesh", 2);
+        auto* resCtrl = dlg.AddInputInteger("Resolution", resolution);
+        auto* chkSolid = dlg.AddCheckBoxWithHeading("Fill", "Solid", true);
+
+        wxIntegerValidator<int> validRes;
+        validRes.SetRange(1, 2048);
+        resCtrl->SetValidator(validRes);
+
+        if (dlg.ShowModal() != wxID_OK) {
+            return;
+        }
+
+        if (!resCtrl->GetValue().ToLong(&resolution) || resolution < 1) {
+            wxMessageDialog dlg(m_project.GetWindow(), "Invalid input(s)!", "Error", wxCENTER | wxICON_ERROR);
+            dlg.ShowModal();
+            return;
+        }
+        solid = chkSolid->GetValue();
+    }
+
+    // The UI keeps running while the model is imported, only its drawables are generated here on the GL thread.
+    ModelImport import(filename, resolution, solid);
+    wxProgressDialog dialog("Importing Model", "Please wait...", 100, m_project.GetWindow(),
+                            wxPD_APP_MODAL | wxPD_CAN_ABORT | wxPD_ELAPSED_TIME | wxPD_SMOOTH);
+    while (!import.WaitFor(std::chrono::milliseconds(16))) {
+        if (!dialog.Update(static_cast<int>(import.GetProgress()))) {
+            import.Cancel();
+        }
+    }
+    dialog.Hide();
+
+    auto model = import.GetResult();
+    if (!model) {
+        if (!import.GetError().empty()) {
+            log_error("Failed to import \"%s\": %s", filename.c_str(), import.GetError().c_str());
+            wxMessageDialog dlg(m_project.GetWindow(), import.GetError(), "Error", wxCENTER | wxICON_ERROR);
+            dlg.ShowModal();
+        }
+        return;
+    }
+
+    Scene::Get(m_project).AddModel(model);
 }
 
 void SceneController::OnAddPlane(wxCommandEvent&)
@@ -205,9 +260,10 @@ void SceneController::OnAddTorus(wxCommandEvent&)
 
 void SceneController::OnAddMap(wxCommandEvent&)
 {
-    AddDialog dlg(m_project.GetWindow(), "Add Map (3 to 2)", 7);
+    AddDialog dlg(m_project.GetWindow(), "Add Map (3 to 2)", 8);
     long width = 32;
     long height = 32;
+    unsigned long long seed = std::random_device {}() & 0x7fffffff;
     bool isCyclicX = false;
     bool isCyclicY = false;
 
@@ -221,6 +277,7 @@ void SceneController::OnAddMap(wxCommandEvent&)
     auto* initStatePlane = dlg.AddRadioButtonWithHeading("Initialize Method", "Plane", true);
     dlg.AddRadioButton("Cylinder", false);
     dlg.AddRadioButton("Random", false);
+    auto* seedCtrl = dlg.AddInputInteger("Seed", static_cast<int>(seed));
 
     wxIntegerValidator<int> validDimen;
     validDimen.SetRange(1, 512);
@@ -231,7 +288,8 @@ void SceneController::OnAddMap(wxCommandEvent&)
         return;
     }
 
-    if (!widthCtrl->GetValue().ToLong(&width) || !heightCtrl->GetValue().ToLong(&height) || width < 2 || height < 2) {
+    if (!widthCtrl->GetValue().ToLong(&width) || !heightCtrl->GetValue().ToLong(&height) || width < 2 || height < 2
+        || !seedCtrl->GetValue().ToULongLong(&seed)) {
         wxMessageDialog dlg(m_project.GetWindow(), "Invalid input(s)!", "Error", wxCENTER | wxICON_ERROR);
         dlg.ShowModal();
         return;
@@ -254,9 +312,9 @@ void SceneController::OnAddMap(wxCommandEvent&)
         ++initState;
     }
 
-    Scene::Get(m_project).AddMap(width, height, flags, static_cast<MapInitState>(initState));
+    Scene::Get(m_project).AddMap(width, height, flags, static_cast<MapInitState>(initState), seed);
 
-    log_info("Added Map: (width: %ld, height: %ld)", width, height);
+    log_info("Added Map: (width: %ld, height: %ld, seed: %llu)", width, height, seed);
 }
 
 void SceneController::OnDeleteObject(wxCommandEvent& event)
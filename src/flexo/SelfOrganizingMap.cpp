@@ -1,11 +1,13 @@
 #include "SelfOrganizingMap.hpp"
-#include "Project.hpp"
 #include "log/Logger.h"
 #include "object/Map.hpp"
 
 SelfOrganizingMap::~SelfOrganizingMap()
 {
-    m_isDone = true;
+    {
+        std::lock_guard lk(m_mut);
+        m_isDone = true;
+    }
     m_cv.notify_one();
 
     if (m_worker.joinable()) {
@@ -16,7 +18,10 @@ SelfOrganizingMap::~SelfOrganizingMap()
 
 void SelfOrganizingMap::ToggleTraining()
 {
-    m_isTraining = !m_isTraining;
+    {
+        std::lock_guard lk(m_mut);
+        m_isTraining = !m_isTraining;
+    }
     m_cv.notify_one();
 
     if (m_isTraining) {
@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "SurfaceExtractor.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SURFACE_EXTRACTOR_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace
+{
+    unsigned char const ModelValue = 255;
+    unsigned char const Air = 0;
+
+    // Slices classified in parallel at a time. The packed slices of a 2048^2 volume take 1 MiB each.
+    int const SlabDepth = 16;
+
+    std::uint64_t const AllBits = ~std::uint64_t(0);
+
+    /**
+     * Occupancy of a slice, one bit per voxel and 64 voxels per word along X
+     *
+     * Rows start at a new word. The padding bits after the last voxel of a row are air, as is everything outside of
+     * the volume, so that faces on the boundary need no special case.
+     */
+    struct BitSlice {
+        std::vector<std::uint64_t> model;
+        std::vector<std::uint64_t> air;
+    };
+
+    int CountTrailingZeros(std::uint64_t x)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(x);
+#endif
+    }
+
+    void PackRow(unsigned char const* row, int n, std::uint64_t* model, std::uint64_t* air)
+    {
+        int x = 0;
+        int w = 0;
+
+#ifdef SURFACE_EXTRACTOR_SSE2
+        __m128i const modelValue = _mm_set1_epi8(static_cast<char>(ModelValue));
+        __m128i const airValue = _mm_set1_epi8(static_cast<char>(Air));
+        for (; x + 64 <= n; x += 64, w++) {
+            std::uint64_t m = 0;
+            std::uint64_t a = 0;
+            for (int i = 0; i < 4; i++) {
+                __m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(row + x + 16 * i));
+                m |= static_cast<std::uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, modelValue))) << (16 * i);
+                a |= static_cast<std::uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, airValue))) << (16 * i);
+            }
+            model[w] = m;
+            air[w] = a;
+        }
+#endif
+
+        for (; x < n; x += 64, w++) {
+            std::uint64_t m = 0;
+            std::uint64_t a = AllBits;
+            int const end = (n - x < 64) ? n - x : 64;
+            for (int i = 0; i < end; i++) {
+                std::uint64_t const bit = std::uint64_t(1) << i;
+                if (row[x + i] == ModelValue) {
+                    m |= bit;
+                }
+                if (row[x + i] != Air) {
+                    a &= ~bit;
+                }
+            }
+            model[w] = m;
+            air[w] = a;
+        }
+    }
+
+    void PackSlice(unsigned char const* slice, glm::ivec3 const& n, int words, BitSlice& packed)
+    {
+        for (int y = 0; y < n.y; y++) {
+            std::size_t const row = static_cast<std::size_t>(y) * words;
+            PackRow(slice + static_cast<std::size_t>(y) * n.x, n.x, &packed.model[row], &packed.air[row]);
+        }
+    }
+
+    void ClearSlice(BitSlice& packed)
+    {
+        std::fill(packed.model.begin(), packed.model.end(), 0);
+        std::fill(packed.air.begin(), packed.air.end(), AllBits);
+    }
+
+    /**
+     * Find the surface voxels of slice z from its packed neighbours, in the order of the volume
+     */
+    void ClassifySlice(BitSlice const& below, BitSlice const& here, BitSlice const& above, glm::ivec3 const& n,
+                       int words, int z, glm::vec3 const& origin, glm::vec3 const& scale, std::vector<Voxel>& out)
+    {
+        for (int y = 0; y < n.y; y++) {
+            std::size_t const row = static_cast<std::size_t>(y) * words;
+            std::uint64_t const* air = &here.air[row];
+            std::uint64_t const* airYPos = (y + 1 < n.y) ? air + words : nullptr;
+            std::uint64_t const* airYNeg = (y > 0) ? air - words : nullptr;
+
+            for (int w = 0; w < words; w++) {
+                std::uint64_t const m = here.model[row + w];
+                if (m == 0) {
+                    continue;
+                }
+
+                // Bit x of each mask tells whether the neighbour of voxel x in that direction is air.
+                std::uint64_t const nextWord = (w + 1 < words) ? air[w + 1] : AllBits;
+                std::uint64_t const prevWord = (w > 0) ? air[w - 1] : AllBits;
+                std::uint64_t const xPos = m & ((air[w] >> 1) | (nextWord << 63));
+                std::uint64_t const xNeg = m & ((air[w] << 1) | (prevWord >> 63));
+                std::uint64_t const yPos = m & (airYPos ? airYPos[w] : AllBits);
+                std::uint64_t const yNeg = m & (airYNeg ? airYNeg[w] : AllBits);
+                std::uint64_t const zPos = m & above.air[row + w];
+                std::uint64_t const zNeg = m & below.air[row + w];
+
+                std::uint64_t surface = xPos | xNeg | yPos | yNeg | zPos | zNeg;
+                while (surface != 0) {
+                    int const bit = CountTrailingZeros(surface);
+                    std::uint64_t const mask = std::uint64_t(1) << bit;
+                    surface &= surface - 1;
+
+                    VoxelVis vis = VoxelVis_None;
+                    vis |= (xPos & mask) ? VoxelVis_XPos : VoxelVis_None;
+                    vis |= (xNeg & mask) ? VoxelVis_XNeg : VoxelVis_None;
+                    vis |= (yPos & mask) ? VoxelVis_YPos : VoxelVis_None;
+                    vis |= (yNeg & mask) ? VoxelVis_YNeg : VoxelVis_None;
+                    vis |= (zPos & mask) ? VoxelVis_ZPos : VoxelVis_None;
+                    vis |= (zNeg & mask) ? VoxelVis_ZNeg : VoxelVis_None;
+
+                    glm::ivec3 const coord { w * 64 + bit, y, z };
+                    out.emplace_back(coord, (origin + glm::vec3(coord)) * scale, glm::vec2(0.0f, 0.0f), vis);
+                }
+            }
+        }
+    }
+}
+
+bool ExtractSurfaceVoxels(VoxelSliceSource const& source, std::function<void(Voxel const&)> const& emit,
+                          ExtractProgress const& progress)
+{
+    glm::ivec3 const n = source.GetResolution();
+    glm::vec3 const scale = source.GetVoxelDims();
+    glm::vec3 const origin = -0.5f * glm::vec3 { (n.x - 1), (n.y - 1), (0 - 1) };
+
+    if (n.x <= 0 || n.y <= 0 || n.z <= 0) {
+        return true;
+    }
+
+    int const words = (n.x + 63) / 64;
+    std::size_t const sliceWords = static_cast<std::size_t>(words) * n.y;
+    std::vector<unsigned char> scratch(static_cast<std::size_t>(n.x) * n.y);
+
+    // packed[i] holds slice z0 - 1 + i, so the slab starting at z0 is surrounded by packed[0] and packed[depth + 1].
+    std::vector<BitSlice> packed(SlabDepth + 2);
+    for (auto& p : packed) {
+        p.model.resize(sliceWords);
+        p.air.resize(sliceWords);
+    }
+
+    auto const load = [&](int z, BitSlice& p) {
+        if (z < n.z) {
+            PackSlice(source.GetSlice(z, scratch.data()), n, words, p);
+        } else {
+            ClearSlice(p);
+        }
+    };
+
+    ClearSlice(packed[0]);
+    load(0, packed[1]);
+
+    std::vector<std::vector<Voxel>> found(SlabDepth);
+
+    for (int z0 = 0; z0 < n.z; z0 += SlabDepth) {
+        int const depth = (n.z - z0 < SlabDepth) ? n.z - z0 : SlabDepth;
+
+        // Reading stays sequential since a source may decompress the slices as it goes.
+        for (int i = 1; i <= depth; i++) {
+            load(z0 + i, packed[i + 1]);
+        }
+
+#pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < depth; i++) {
+            found[i].clear();
+            ClassifySlice(packed[i], packed[i + 1], packed[i + 2], n, words, z0 + i, origin, scale, found[i]);
+        }
+
+        for (int i = 0; i < depth; i++) {
+            for (auto const& vx : found[i]) {
+                emit(vx);
+            }
+        }
+
+        // The last slice of the slab and the one after it become the border of the next slab.
+        std::swap(packed[0], packed[depth]);
+        std::swap(packed[1], packed[depth + 1]);
+
+        if (progress && !progress(100.0f * (z0 + depth) / n.z)) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <limits>
+
+#include "TriangleBVH.hpp"
+
+namespace
+{
+    unsigned int const LeafSize = 4;
+    unsigned int const MaxDepth = 64;
+
+    float SquaredDistanceToBox(glm::vec3 const& point, glm::vec3 const& min, glm::vec3 const& max)
+    {
+        glm::vec3 const d = glm::max(glm::max(min - point, point - max), glm::vec3(0.0f));
+        return glm::dot(d, d);
+    }
+}
+
+TriangleBVH::TriangleBVH(std::vector<glm::vec3> const& positions, std::vector<TriangularFace> const& faces)
+    : m_order(faces.size())
+    , m_boxes(faces.size())
+    , m_centroids(faces.size())
+{
+    for (unsigned int i = 0; i < faces.size(); i++) {
+        glm::vec3 const& a = positions[faces[i].x];
+        glm::vec3 const& b = positions[faces[i].y];
+        glm::vec3 const& c = positions[faces[i].z];
+        m_order[i] = i;
+        m_boxes[i] = Box { glm::min(glm::min(a, b), c), glm::max(glm::max(a, b), c) };
+        m_centroids[i] = (a + b + c) / 3.0f;
+    }
+
+    if (!faces.empty()) {
+        m_nodes.reserve(2 * (faces.size() / LeafSize + 1));
+        Build(0, faces.size());
+    }
+
+    // Lay the faces out in leaf order so that a leaf reads one contiguous run.
+    std::vector<Box> boxes(faces.size());
+    m_triangles.reserve(faces.size());
+    for (unsigned int i = 0; i < faces.size(); i++) {
+        auto const& f = faces[m_order[i]];
+        boxes[i] = m_boxes[m_order[i]];
+        m_triangles.emplace_back(positions[f.x], positions[f.y], positions[f.z]);
+    }
+    m_boxes = std::move(boxes);
+    m_centroids = std::vector<glm::vec3>();
+}
+
+unsigned int TriangleBVH::Build(unsigned int first, unsigned int count)
+{
+    unsigned int const index = m_nodes.size();
+    m_nodes.push_back(Node {});
+
+    Box box { glm::vec3(std::numeric_limits<float>::max()), glm::vec3(std::numeric_limits<float>::lowest()) };
+    Box centroids = box;
+    for (unsigned int i = first; i < first + count; i++) {
+        unsigned int const face = m_order[i];
+        box.min = glm::min(box.min, m_boxes[face].min);
+        box.max = glm::max(box.max, m_boxes[face].max);
+        centroids.min = glm::min(centroids.min, m_centroids[face]);
+        centroids.max = glm::max(centroids.max, m_centroids[face]);
+    }
+
+    if (count <= LeafSize) {
+        m_nodes[index] = Node { box, first, count };
+        return index;
+    }
+
+    // Median split along the longest axis of the centroid bounds keeps the tree balanced.
+    glm::vec3 const extent = centroids.max - centroids.min;
+    int axis = 0;
+    if (extent.y > extent[axis]) {
+        axis = 1;
+    }
+    if (extent.z > extent[axis]) {
+        axis = 2;
+    }
+
+    unsigned int const half = count / 2;
+    auto const begin = m_order.begin() + first;
+    std::nth_element(begin, begin + half, begin + count, [this, axis](unsigned int a, unsigned int b) {
+        return m_centroids[a][axis] < m_centroids[b][axis];
+    });
+
+    Build(first, half);
+    unsigned int const right = Build(first + half, count - half);
+    m_nodes[index] = Node { box, right, 0 };
+    return index;
+}
+
+unsigned int TriangleBVH::FindClosest(glm::vec3 const& point, glm::vec3& closest) const
+{
+    unsigned int nearest = m_order.size();
+    float distMin = std::numeric_limits<float>::max();
+
+    if (m_nodes.empty()) {
+        return nearest;
+    }
+
+    unsigned int stack[MaxDepth];
+    unsigned int top = 0;
+    stack[top++] = 0;
+
+    // The closest point on a triangle may lie slightly outside its box due to rounding, so the bound is loosened a
+    // little to never prune a face the brute-force search would have picked.
+    float bound = std::numeric_limits<float>::max();
+
+    while (top > 0) {
+        Node const& node = m_nodes[stack[--top]];
+        if (SquaredDistanceToBox(point, node.box.min, node.box.max) > bound) {
+            continue;
+        }
+
+        if (node.count > 0) {
+            for (unsigned int i = node.first; i < node.first + node.count; i++) {
+                if (SquaredDistanceToBox(point, m_boxes[i].min, m_boxes[i].max) > bound) {
+                    continue;
+                }
+                unsigned int const face = m_order[i];
+                glm::vec3 const p = m_triangles[i].ClosestPointTo(point);
+                float const dist = geom::SquaredDistance(point, p);
+                if (dist < distMin || (dist == distMin && face < nearest)) {
+                    distMin = dist;
+                    nearest = face;
+                    closest = p;
+                    bound = distMin + distMin * 1e-4f;
+                }
+            }
+            continue;
+        }
+
+        unsigned int const left = (&node - m_nodes.data()) + 1;
+        unsigned int const right = node.first;
+        float const distLeft = SquaredDistanceToBox(point, m_nodes[left].box.min, m_nodes[left].box.max);
+        float const distRight = SquaredDistanceToBox(point, m_nodes[right].box.min, m_nodes[right].box.max);
+
+        // Visit the nearer child first so that the bound shrinks quickly.
+        if (distLeft <= distRight) {
+            stack[top++] = right;
+            stack[top++] = left;
+        } else {
+            stack[top++] = left;
+            stack[top++] = right;
+        }
+    }
+
+    return nearest;
+}
@@ -1,9 +1,10 @@
-#include <cstdlib>
+#include <csetjmp>
+#include <cstring>
 
 #include "VolumetricModelData.hpp"
-#include "log/Logger.h"
 
 VolumetricModelData::VolumetricModelData()
+    : m_data(nullptr)
 {
     m_rvl = rvl_create_reader();
 }
@@ -13,10 +14,42 @@ VolumetricModelData::~VolumetricModelData()
     rvl_destroy(&m_rvl);
 }
 
-void VolumetricModelData::Read(std::string const filename)
+// librvl jumps back to the setjmp of the calling function on errors, so every function that calls it sets one up
+// before any object with a destructor is created.
+
+bool VolumetricModelData::Read(std::string const filename)
+{
+    if (!Open(filename)) {
+        return false;
+    }
+
+    if (m_data == nullptr) {
+        m_storage.resize(static_cast<std::size_t>(m_resolution.x) * m_resolution.y * m_resolution.z);
+        if (setjmp(*rvl_error_jmpbuf(m_rvl)) != 0) {
+            m_error = rvl_get_error(m_rvl);
+            m_storage = std::vector<unsigned char>();
+            return false;
+        }
+        rvl_read_voxels_to(m_rvl, m_storage.data());
+        m_data = m_storage.data();
+    }
+
+    return true;
+}
+
+bool VolumetricModelData::Open(std::string const filename)
 {
+    if (setjmp(*rvl_error_jmpbuf(m_rvl)) != 0) {
+        m_error = rvl_get_error(m_rvl);
+        return false;
+    }
+
+    m_error.clear();
+    m_data = nullptr;
+    m_storage.clear();
+
     rvl_set_file(m_rvl, filename.c_str());
-    rvl_read_rvl(m_rvl);
+    rvl_read_info(m_rvl);
 
     RVLenum primitive;
     RVLenum endian;
@@ -27,8 +60,8 @@ void VolumetricModelData::Read(std::string const filename)
     rvl_get_volumetric_format(m_rvl, &res.x, &res.y, &res.z, &primitive, &endian);
 
     if ((primitive != RVL_PRIMITIVE_U8) || rvl_get_grid_type(m_rvl) != RVL_GRID_REGULAR) {
-        log_error("Wrong type of volumetric data!");
-        exit(EXIT_FAILURE);
+        m_error = "Wrong type of volumetric data";
+        return false;
     }
 
     rvl_get_voxel_dims(m_rvl, &dims.x, &dims.y, &dims.z);
@@ -37,12 +70,42 @@ void VolumetricModelData::Read(std::string const filename)
     m_resolution = res;
     m_vxDims = dims;
     m_origin = orig;
+
+    // Uncompressed voxels are used straight from the page cache.
+    if (rvl_get_compression(m_rvl) == RVL_COMPRESSION_NONE) {
+        m_data = static_cast<unsigned char const*>(rvl_map_voxels(m_rvl));
+    }
+
+    // Slices are read in order, so a slice that straddles two blocks is the most that has to be kept.
+    rvl_set_block_cache_size(m_rvl, 2);
+
+    return true;
+}
+
+std::string const& VolumetricModelData::GetError() const
+{
+    return m_error;
 }
 
 unsigned char const* VolumetricModelData::GetBuffer() const
 {
-    void const* buf = rvl_get_voxels(m_rvl);
-    return static_cast<unsigned char const*>(buf);
+    return m_data;
+}
+
+unsigned char const* VolumetricModelData::GetSlice(int z, unsigned char* scratch) const
+{
+    std::size_t const sliceSize = static_cast<std::size_t>(m_resolution.x) * m_resolution.y;
+    if (m_data != nullptr) {
+        return m_data + z * sliceSize;
+    }
+
+    if (setjmp(*rvl_error_jmpbuf(m_rvl)) != 0) {
+        m_error = rvl_get_error(m_rvl);
+        std::memset(scratch, 0, sliceSize);
+        return scratch;
+    }
+    rvl_read_region(m_rvl, 0, 0, z, m_resolution.x, m_resolution.y, 1, scratch);
+    return scratch;
 }
 
 glm::ivec3 VolumetricModelData::GetResolution() const
@@ -1,7 +1,8 @@
 #include "Voxel.hpp"
 
-Voxel::Voxel(glm::vec3 pos, glm::vec2 uv, VoxelVis vis)
-    : pos(pos)
+Voxel::Voxel(glm::ivec3 coord, glm::vec3 pos, glm::vec2 uv, VoxelVis vis)
+    : coord(coord)
+    , pos(pos)
     , uv(uv)
     , vis(vis)
 {
@@ -2,22 +2,35 @@
 
 #include <filesystem>
 #include <fstream>
-#include <iostream>
 
-void BaseImporter::Slurp(std::string const& filename)
+bool BaseImporter::Slurp(std::string const& filename)
 {
     using namespace std;
     namespace fs = std::filesystem;
 
+    m_error.clear();
+
     ifstream fh;
     fh.open(filename, ios::binary);
     if (fh.fail()) {
-        cerr << "Failed to open file: \"" << filename << "\"" << endl;
-        exit(EXIT_FAILURE);
+        m_error = "Failed to open file: \"" + filename + "\"";
+        return false;
     }
 
-    size_t fileSize = fs::file_size(filename);
+    error_code ec;
+    size_t fileSize = fs::file_size(filename, ec);
+    if (ec) {
+        m_error = "Failed to read file: \"" + filename + "\"";
+        return false;
+    }
     m_buffer.resize(fileSize);
     fh.read(reinterpret_cast<char*>(m_buffer.data()), fileSize);
     fh.close();
+
+    return true;
+}
+
+std::string const& BaseImporter::GetError() const
+{
+    return m_error;
 }
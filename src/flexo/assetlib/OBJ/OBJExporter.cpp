@@ -0,0 +1,46 @@
+#include "assetlib/OBJ/OBJExporter.hpp"
+
+#include <cstdio>
+
+#include "log/Logger.h"
+
+bool OBJExporter::WriteFile(std::string const& filename, EditableMesh const& mesh) const
+{
+    FILE* fp = std::fopen(filename.c_str(), "w");
+    if (!fp) {
+        log_error("Failed to open file: \"%s\"", filename.c_str());
+        return false;
+    }
+
+    bool const hasUV = mesh.textureCoords.size() == mesh.positions.size();
+
+    for (auto const& p : mesh.positions) {
+        std::fprintf(fp, "v %.6f %.6f %.6f\n", p.x, p.y, p.z);
+    }
+
+    if (hasUV) {
+        for (auto const& uv : mesh.textureCoords) {
+            std::fprintf(fp, "vt %.6f %.6f\n", uv.x, uv.y);
+        }
+    }
+
+    // OBJ indices are 1-based.
+    for (auto const& face : mesh.faces) {
+        std::fputc('f', fp);
+        for (unsigned int idx : face) {
+            if (hasUV) {
+                std::fprintf(fp, " %u/%u", idx + 1, idx + 1);
+            } else {
+                std::fprintf(fp, " %u", idx + 1);
+            }
+        }
+        std::fputc('\n', fp);
+    }
+
+    bool const failed = std::ferror(fp) != 0;
+    if (std::fclose(fp) != 0 || failed) {
+        log_error("Failed to write file: \"%s\"", filename.c_str());
+        return false;
+    }
+    return true;
+}
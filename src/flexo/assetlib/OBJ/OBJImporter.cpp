@@ -1,96 +1,298 @@
 #include "assetlib/OBJ/OBJImporter.hpp"
 
-#include <iostream>
-#include <sstream>
-#include <unordered_map>
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cstring>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "gfx/WeldVertices.hpp"
+
+namespace
+{
+    // Files are split into chunks of about this size, which are parsed in parallel.
+    std::size_t const ChunkSize = 1 << 20;
+
+    bool IsSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    char const* SkipSpaces(char const* p, char const* last)
+    {
+        while (p < last && IsSpace(*p)) {
+            p++;
+        }
+        return p;
+    }
+
+    char const* FindLineEnd(char const* p, char const* last)
+    {
+        auto const* eol = static_cast<char const*>(std::memchr(p, '\n', last - p));
+        return eol ? eol : last;
+    }
+
+    bool ParseFloat(char const*& p, char const* last, float& value)
+    {
+        p = SkipSpaces(p, last);
+        if (p < last && *p == '+') {
+            p++;
+        }
+        auto const [end, ec] = std::from_chars(p, last, value);
+        if (ec != std::errc()) {
+            return false;
+        }
+        p = end;
+        return true;
+    }
+
+    bool ParseVec3(char const*& p, char const* last, glm::vec3& v)
+    {
+        return ParseFloat(p, last, v.x) && ParseFloat(p, last, v.y) && ParseFloat(p, last, v.z);
+    }
+}
+
 Mesh OBJImporter::ReadFile(std::string const& filename)
 {
-    using namespace std;
+    if (!Slurp(filename)) {
+        return Mesh();
+    }
 
-    OBJModel model;
+    char const* const data = reinterpret_cast<char const*>(m_buffer.data());
+    char const* const end = data + m_buffer.size();
 
-    Slurp(filename);
+    // Every chunk ends after a line break, so no line is split between two chunks.
+    std::vector<char const*> bounds { data };
+    while (bounds.back() != end) {
+        char const* const first = bounds.back();
+        char const* const eol = FindLineEnd(first + std::min<std::size_t>(ChunkSize, end - first), end);
+        bounds.push_back(eol == end ? end : eol + 1);
+    }
 
-    istringstream iss(string(m_buffer.cbegin(), m_buffer.cend()));
+    std::vector<Chunk> chunks(bounds.size() - 1);
+    int const count = chunks.size();
 
-    string token;
-    glm::vec3 p, n;
+#pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < count; i++) {
+        ParseChunk(bounds[i], bounds[i + 1], chunks[i]);
+    }
 
-    auto& [v, vn, f] = model;
-    while (iss >> token) {
-        if (token == "v") {
-            bool success = iss >> p.x && iss >> p.y && iss >> p.z;
-            if (!success) {
-                cerr << "Error occurred when parsing \"v\"." << endl;
-                exit(EXIT_FAILURE);
+    for (auto const& chunk : chunks) {
+        if (chunk.error) {
+            char const* eol = FindLineEnd(chunk.error, end);
+            while (eol > chunk.error && IsSpace(eol[-1])) {
+                eol--;
             }
-            v.push_back(p);
-        } else if (token == "vt") {
-            // TODO
-        } else if (token == "vn") {
-            bool success = iss >> n.x && iss >> n.y && iss >> n.z;
-            if (!success) {
-                cerr << "Error occurred when parsing \"vn\"." << endl;
-                exit(EXIT_FAILURE);
+            m_error = "Failed to parse \"" + filename + "\" at: \"" + std::string(chunk.error, eol) + "\"";
+            m_buffer = std::vector<unsigned char>();
+            return Mesh();
+        }
+    }
+
+    OBJModel const model = MergeChunks(chunks);
+    m_buffer = std::vector<unsigned char>();
+
+    return BuildMesh(model);
+}
+
+void OBJImporter::ParseChunk(char const* first, char const* last, Chunk& chunk)
+{
+    using VertexRef = OBJModel::VertexRef;
+
+    auto& model = chunk.model;
+
+    // attrib: 0 for v, 1 for vt and 2 for vn
+    auto const parseIndex = [&chunk, &model](char const*& p, char const* eol, int attrib, std::size_t count,
+                                             int& index) -> bool {
+        int i;
+        auto const [end, ec] = std::from_chars(p, eol, i);
+        if (ec != std::errc() || i == 0) {
+            return false;
+        }
+        p = end;
+        if (i > 0) {
+            index = i - 1;
+        } else {
+            index = static_cast<int>(count) + i;
+            chunk.relative[attrib].push_back(model.refs.size());
+        }
+        return true;
+    };
+
+    char const* line = first;
+    while (line < last) {
+        char const* const eol = FindLineEnd(line, last);
+        char const* p = SkipSpaces(line, eol);
+        char const* keyEnd = p;
+        while (keyEnd < eol && !IsSpace(*keyEnd)) {
+            keyEnd++;
+        }
+        std::string_view const key(p, keyEnd - p);
+        p = keyEnd;
+
+        bool success = true;
+        if (key == "v") {
+            glm::vec3 v;
+            success = ParseVec3(p, eol, v);
+            model.positions.push_back(v);
+        } else if (key == "vt") {
+            glm::vec2 vt(0.0f, 0.0f);
+            success = ParseFloat(p, eol, vt.x);
+            // The v coordinate is optional.
+            char const* q = p;
+            if (ParseFloat(q, eol, vt.y)) {
+                p = q;
             }
-            vn.push_back(n);
-        } else if (token == "f") {
-            string line;
-            string triref;
-            getline(iss, line);
-            istringstream lineiss(line);
-            OBJModel::VertexRef vref;
-            OBJModel::Face face;
-            while (lineiss >> triref) {
-                int ret = sscanf(triref.c_str(), "%d/%d/%d", &vref.v, &vref.vt, &vref.vn);
-                if (ret != 3) {
-                    ret = sscanf(triref.c_str(), "%d//%d", &vref.v, &vref.vn);
-                    vref.vt = 0;
-                    if (ret != 2) {
-                        cerr << "Wront \"f\" format!" << endl;
-                        exit(EXIT_FAILURE);
+            model.textureCoords.push_back(vt);
+        } else if (key == "vn") {
+            glm::vec3 vn;
+            success = ParseVec3(p, eol, vn);
+            model.normals.push_back(vn);
+        } else if (key == "f") {
+            // v, v/vt, v//vn or v/vt/vn
+            unsigned int size = 0;
+            for (p = SkipSpaces(p, eol); success && p < eol; p = SkipSpaces(p, eol)) {
+                VertexRef ref { -1, -1, -1 };
+                success = parseIndex(p, eol, 0, model.positions.size(), ref.v);
+                if (success && p < eol && *p == '/') {
+                    p++;
+                    if (p < eol && *p != '/') {
+                        success = parseIndex(p, eol, 1, model.textureCoords.size(), ref.vt);
+                    }
+                    if (success && p < eol && *p == '/') {
+                        p++;
+                        success = parseIndex(p, eol, 2, model.normals.size(), ref.vn);
                     }
                 }
-                face.push_back(vref);
+                success = success && (p == eol || IsSpace(*p));
+                model.refs.push_back(ref);
+                size++;
             }
-            f.push_back(face);
+            success = success && size > 0;
+            model.faceSizes.push_back(size);
         }
-    }
 
-    return BuildMesh(model);
+        if (!success) {
+            chunk.error = line;
+            return;
+        }
+
+        line = eol + 1;
+    }
 }
 
-Mesh OBJImporter::BuildMesh(OBJModel const& model) const
+OBJImporter::OBJModel OBJImporter::MergeChunks(std::vector<Chunk>& chunks)
 {
-    using namespace std;
+    OBJModel model;
 
-    Mesh mesh;
+    std::size_t sizes[5] = { 0, 0, 0, 0, 0 };
+    for (auto const& chunk : chunks) {
+        sizes[0] += chunk.model.positions.size();
+        sizes[1] += chunk.model.textureCoords.size();
+        sizes[2] += chunk.model.normals.size();
+        sizes[3] += chunk.model.refs.size();
+        sizes[4] += chunk.model.faceSizes.size();
+    }
+    model.positions.reserve(sizes[0]);
+    model.textureCoords.reserve(sizes[1]);
+    model.normals.reserve(sizes[2]);
+    model.refs.reserve(sizes[3]);
+    model.faceSizes.reserve(sizes[4]);
 
-    auto const& [positions, normals, faces] = model;
-    unordered_map<size_t, vector<size_t>> faceIdxMap;
+    for (auto& chunk : chunks) {
+        auto& part = chunk.model;
 
-    for (OBJModel::Face const& face : faces) {
-        auto const vertNum = face.size();
-        // Convex polygon triangulation
-        if (faceIdxMap.find(vertNum) == faceIdxMap.end()) {
-            vector<size_t> idx;
-            idx.reserve(3 * (vertNum - 2));
-            for (size_t j = 1; j <= vertNum - 2; ++j) {
-                idx.push_back(0);
-                idx.push_back(j);
-                idx.push_back(j + 1);
+        // A negative index that points before the first attribute of the file becomes an invalid one.
+        auto const shift = [](int& index, std::size_t offset) {
+            index += static_cast<int>(offset);
+            if (index < 0) {
+                index = INT_MAX;
             }
-            faceIdxMap.insert({ vertNum, idx });
+        };
+        for (std::size_t i : chunk.relative[0]) {
+            shift(part.refs[i].v, model.positions.size());
+        }
+        for (std::size_t i : chunk.relative[1]) {
+            shift(part.refs[i].vt, model.textureCoords.size());
+        }
+        for (std::size_t i : chunk.relative[2]) {
+            shift(part.refs[i].vn, model.normals.size());
+        }
+
+        model.positions.insert(model.positions.end(), part.positions.begin(), part.positions.end());
+        model.textureCoords.insert(model.textureCoords.end(), part.textureCoords.begin(), part.textureCoords.end());
+        model.normals.insert(model.normals.end(), part.normals.begin(), part.normals.end());
+        model.refs.insert(model.refs.end(), part.refs.begin(), part.refs.end());
+        model.faceSizes.insert(model.faceSizes.end(), part.faceSizes.begin(), part.faceSizes.end());
+        part = OBJModel();
+    }
+
+    return model;
+}
+
+Mesh OBJImporter::BuildMesh(OBJModel const& model)
+{
+    Mesh mesh;
+
+    auto const& refs = model.refs;
+    auto const& faceSizes = model.faceSizes;
+
+    // The texture coordinates and normals are only kept if every vertex has them.
+    bool hasTextureCoords = true;
+    bool hasNormals = true;
+    for (auto const& ref : refs) {
+        if (ref.v < 0 || ref.v >= static_cast<int>(model.positions.size())
+            || ref.vt >= static_cast<int>(model.textureCoords.size())
+            || ref.vn >= static_cast<int>(model.normals.size())) {
+            m_error = "OBJ face refers to a vertex attribute that does not exist";
+            return Mesh();
         }
+        hasTextureCoords = hasTextureCoords && (ref.vt >= 0);
+        hasNormals = hasNormals && (ref.vn >= 0);
+    }
+
+    // Each face becomes a triangle fan that starts after the triangles of the faces before it.
+    int const faceCount = faceSizes.size();
+    std::vector<std::size_t> firstRef(faceCount);
+    std::vector<std::size_t> firstVertex(faceCount);
+    std::size_t refCount = 0;
+    std::size_t vertexCount = 0;
+    for (int i = 0; i < faceCount; i++) {
+        firstRef[i] = refCount;
+        firstVertex[i] = vertexCount;
+        refCount += faceSizes[i];
+        vertexCount += (faceSizes[i] >= 3) ? 3 * (faceSizes[i] - 2) : 0;
+    }
 
-        for (size_t i : faceIdxMap[vertNum]) {
-            OBJModel::VertexRef const& vref = face[i];
-            mesh.positions.push_back(positions[vref.v - 1]);
-            mesh.normals.push_back(normals[vref.vn - 1]);
+    mesh.positions.resize(vertexCount);
+    if (hasTextureCoords) {
+        mesh.textureCoords.resize(vertexCount);
+    }
+    if (hasNormals) {
+        mesh.normals.resize(vertexCount);
+    }
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < faceCount; i++) {
+        OBJModel::VertexRef const* face = &refs[firstRef[i]];
+        std::size_t out = firstVertex[i];
+
+        // Convex polygon triangulation
+        for (unsigned int j = 1; j + 1 < faceSizes[i]; j++) {
+            for (unsigned int k : { 0u, j, j + 1 }) {
+                mesh.positions[out] = model.positions[face[k].v];
+                if (hasTextureCoords) {
+                    mesh.textureCoords[out] = model.textureCoords[face[k].vt];
+                }
+                if (hasNormals) {
+                    mesh.normals[out] = model.normals[face[k].vn];
+                }
+                out++;
+            }
         }
     }
 
-    return mesh;
+    return WeldVertices(mesh);
 }
@@ -1,20 +1,24 @@
 #include "assetlib/STL/STLImporter.hpp"
 
-#include <filesystem>
-#include <fstream>
-#include <iostream>
 #include <sstream>
 #include <string_view>
 
+#include "gfx/WeldVertices.hpp"
+
 bool STLImporter::IsAsciiSTL() const
 {
+    if (m_buffer.size() < 5) {
+        return false;
+    }
     std::string_view solidStr(reinterpret_cast<const char*>(m_buffer.data()), 5);
     return solidStr == "solid";
 }
 
 Mesh STLImporter::ReadFile(std::string const& filename)
 {
-    Slurp(filename);
+    if (!Slurp(filename)) {
+        return Mesh();
+    }
 
     if (IsAsciiSTL()) {
         return ImportAsciiSTL();
@@ -55,12 +59,9 @@ Mesh STLImporter::ImportAsciiSTL()
             case 2: {
                 bool const success = iss >> n.x && iss >> n.y && iss >> n.z;
                 if (!success) {
-                    cerr << "Error: Wrong normal format" << endl;
-                    exit(EXIT_FAILURE);
+                    m_error = "Wrong normal format";
+                    return Mesh();
                 }
-                mesh.normals.push_back(n);
-                mesh.normals.push_back(n);
-                mesh.normals.push_back(n);
                 state = 3;
             } break;
             case 3:
@@ -74,8 +75,8 @@ Mesh STLImporter::ImportAsciiSTL()
             case 7: {
                 bool const success = iss >> p.x && iss >> p.y && iss >> p.z;
                 if (!success) {
-                    cerr << "Error: Wrong vertex format" << endl;
-                    exit(EXIT_FAILURE);
+                    m_error = "Wrong vertex format";
+                    return Mesh();
                 }
                 mesh.positions.push_back(p);
                 state = state + 1;
@@ -90,30 +91,40 @@ Mesh STLImporter::ImportAsciiSTL()
                 break;
             }
         } else {
-            cout << "Wrong format. Expecting the token to be \"" << keywords[state] << "\", got \"" << token
-                 << "\" instead." << endl;
-            exit(EXIT_FAILURE);
+            m_error = "Wrong format. Expecting the token to be \"" + keywords[state] + "\", got \"" + token
+                      + "\" instead.";
+            return Mesh();
         }
     }
 
-    return mesh;
+    // The facet normals would keep the triangles from sharing vertices, and the shaders derive them anyway.
+    return WeldVertices(mesh, 0.0f, WeldFlags_None);
 }
 
 Mesh STLImporter::ImportBinarySTL()
 {
     Mesh mesh;
 
+    // A header of 80 bytes and the number of triangles come before the triangles.
+    if (m_buffer.size() < 84) {
+        m_error = "The binary STL file is truncated";
+        return Mesh();
+    }
+
     unsigned int* numTriangles = reinterpret_cast<unsigned int*>(m_buffer.data() + 80);
     Triangle* triangles = reinterpret_cast<Triangle*>(m_buffer.data() + 84);
 
+    if (m_buffer.size() - 84 < sizeof(Triangle) * static_cast<std::size_t>(*numTriangles)) {
+        m_error = "The binary STL file is truncated";
+        return Mesh();
+    }
+
+    mesh.positions.reserve(3 * static_cast<std::size_t>(*numTriangles));
     for (unsigned int i = 0; i < *numTriangles; i++) {
-        mesh.normals.push_back(triangles[i].n);
-        mesh.normals.push_back(triangles[i].n);
-        mesh.normals.push_back(triangles[i].n);
         mesh.positions.push_back(triangles[i].p1);
         mesh.positions.push_back(triangles[i].p2);
         mesh.positions.push_back(triangles[i].p3);
     }
 
-    return mesh;
+    return WeldVertices(mesh, 0.0f, WeldFlags_None);
 }
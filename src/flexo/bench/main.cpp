@@ -0,0 +1,308 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <rvl.h>
+
+#include "Dataset.hpp"
+#include "NodeGrid.hpp"
+#include "NodeKernels.hpp"
+#include "SelfOrganizingMap.hpp"
+#include "SelfOrganizingMapModel.hpp"
+#include "VolumetricModelData.hpp"
+#include "log/Logger.h"
+#include "object/Map.hpp"
+#include "object/SurfaceVoxels.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::vector<std::string> models;
+        std::vector<int> synthetic;
+        int mapSize = 64;
+        int steps = 20000;
+        int epochs = 5;
+        int queries = 100000;
+        unsigned int seed = 5489u;
+    };
+
+    double Seconds(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    void Report(char const* name, double value, char const* unit)
+    {
+        std::printf("  %-32s %14.2f %s\n", name, value, unit);
+    }
+
+    void PrintUsage(char const* program)
+    {
+        std::printf("Usage: %s [options] [model.rvl...]\n"
+                    "\n"
+                    "Benchmark the SOM hot paths on volumetric models.\n"
+                    "Without models or synthetic grids, the bundled demo models are used.\n"
+                    "\n"
+                    "Options:\n"
+                    "  --synthetic <n>  Also run on a generated n^3 grid, can be given more than once\n"
+                    "  --map <n>        Map width and height (default: 64)\n"
+                    "  --steps <n>      Online training steps (default: 20000)\n"
+                    "  --epochs <n>     Batch training epochs (default: 5)\n"
+                    "  --queries <n>    BMU queries (default: 100000)\n"
+                    "  --seed <n>       Seed of the generated data, queries and training (default: 5489)\n"
+                    "  --help           Show this message\n",
+                    program);
+    }
+
+    bool ParseArguments(int argc, char* argv[], Options& opts)
+    {
+        for (int i = 1; i < argc; i++) {
+            char const* arg = argv[i];
+            bool const hasValue = (i + 1 < argc);
+
+            if (std::strcmp(arg, "--help") == 0) {
+                PrintUsage(argv[0]);
+                exit(EXIT_SUCCESS);
+            } else if (std::strcmp(arg, "--synthetic") == 0 && hasValue) {
+                opts.synthetic.push_back(std::atoi(argv[++i]));
+            } else if (std::strcmp(arg, "--map") == 0 && hasValue) {
+                opts.mapSize = std::atoi(argv[++i]);
+            } else if (std::strcmp(arg, "--steps") == 0 && hasValue) {
+                opts.steps = std::atoi(argv[++i]);
+            } else if (std::strcmp(arg, "--epochs") == 0 && hasValue) {
+                opts.epochs = std::atoi(argv[++i]);
+            } else if (std::strcmp(arg, "--queries") == 0 && hasValue) {
+                opts.queries = std::atoi(argv[++i]);
+            } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+                opts.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg[0] == '-' && arg[1] == '-') {
+                log_error("Unknown or incomplete option: \"%s\"", arg);
+                return false;
+            } else {
+                opts.models.push_back(arg);
+            }
+        }
+
+        if (opts.mapSize < 2 || opts.steps < 1 || opts.epochs < 1 || opts.queries < 1) {
+            log_error("Invalid benchmark parameters");
+            return false;
+        }
+
+        if (opts.models.empty() && opts.synthetic.empty()) {
+            for (char const* name : { "stanford_bunny.rvl", "utah_teapot.rvl", "vase01.rvl" }) {
+                opts.models.push_back((std::filesystem::path(FLEXO_BENCH_DATA_DIR) / name).string());
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Write a lumpy sphere of n^3 voxels to an RVL file
+     *
+     * The radius is modulated by a few low-frequency waves with seeded phases, so the surface is not trivially
+     * symmetric but the same seed always produces the same grid.
+     */
+    void WriteSyntheticGrid(std::string const& filename, int n, unsigned int seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> phase(0.0f, 6.2831853f);
+        std::array<float, 3> phases;
+        for (auto& p : phases) {
+            p = phase(rng);
+        }
+
+        std::vector<unsigned char> voxels(static_cast<std::size_t>(n) * n * n, 0);
+        float const center = 0.5f * n;
+        float const radius = 0.4f * n;
+
+        for (int z = 0; z < n; z++) {
+            for (int y = 0; y < n; y++) {
+                for (int x = 0; x < n; x++) {
+                    float const dx = x + 0.5f - center;
+                    float const dy = y + 0.5f - center;
+                    float const dz = z + 0.5f - center;
+                    float const dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+                    float const theta = std::atan2(dy, dx);
+                    float const phi = std::acos(std::clamp(dz / std::max(dist, 1e-6f), -1.0f, 1.0f));
+                    float const bump = 0.06f * std::sin(3.0f * theta + phases[0])
+                        + 0.04f * std::sin(5.0f * phi + phases[1])
+                        + 0.03f * std::sin(2.0f * theta + 4.0f * phi + phases[2]);
+                    if (dist < radius * (1.0f + bump)) {
+                        voxels[x + y * n + static_cast<std::size_t>(z) * n * n] = 255;
+                    }
+                }
+            }
+        }
+
+        float const size = 1.0f / static_cast<float>(n);
+        RVL* rvl = rvl_create_writer();
+        rvl_set_file(rvl, filename.c_str());
+        rvl_set_regular_grid(rvl, size, size, size);
+        rvl_set_volumetric_format(rvl, n, n, n, RVL_PRIMITIVE_U8, RVL_ENDIAN_LITTLE);
+        rvl_set_voxels(rvl, voxels.data());
+        rvl_write_rvl(rvl);
+        rvl_destroy(&rvl);
+    }
+
+    /**
+     * Place the nodes on seeded samples of the dataset so that the BMU searches see a realistic distribution
+     */
+    std::shared_ptr<Map<3, 2>> ConstructSampledMap(int size, std::vector<Vec3f> const& data, std::mt19937& rng)
+    {
+        auto map = ConstructMap(size, size, MapFlags_CyclicNone, MapInitState_Plane);
+        std::uniform_int_distribution<std::size_t> pick(0, data.size() - 1);
+        for (std::size_t i = 0; i < map->nodes.size(); i++) {
+            map->nodes.SetWeights(i, data[pick(rng)]);
+        }
+        return map;
+    }
+
+    void BenchmarkBMU(Options const& opts, Dataset<3> const& dataset, std::mt19937& rng)
+    {
+        auto const& data = dataset.GetData();
+        auto map = ConstructSampledMap(opts.mapSize, data, rng);
+        auto const& nodes = map->nodes;
+
+        std::uniform_int_distribution<std::size_t> pick(0, data.size() - 1);
+        std::vector<Vec3f> queries(opts.queries);
+        for (auto& q : queries) {
+            q = data[pick(rng)];
+        }
+
+        auto const weights = nodes.WeightPointers();
+        unsigned int checksum = 0;
+
+        auto start = Clock::now();
+        for (auto const& q : queries) {
+            std::array<float, 3> const in = { q[0], q[1], q[2] };
+            checksum += kernel::FindNearest(weights.data(), 3, nodes.size(), in.data());
+        }
+        Report("BMU brute force", 1e9 * Seconds(start) / queries.size(), "ns/BMU");
+
+        NodeGrid<3> grid(dataset.GetBoundingBox(), nodes.size());
+        for (unsigned int i = 0; i < nodes.size(); i++) {
+            grid.Update(i, nodes.GetWeights(i));
+        }
+
+        start = Clock::now();
+        for (auto const& q : queries) {
+            checksum -= grid.FindNearest(q);
+        }
+        Report("BMU uniform grid", 1e9 * Seconds(start) / queries.size(), "ns/BMU");
+
+        // Both searches find the same nodes, so anything else means the benchmark is broken.
+        if (checksum != 0) {
+            log_error("BMU searches disagree");
+        }
+    }
+
+    void BenchmarkTraining(Options const& opts, std::shared_ptr<SurfaceVoxels> model, std::shared_ptr<Map<3, 2>> map,
+                           TrainingMode mode, BMUSearch search, char const* name, char const* unit)
+    {
+        SelfOrganizingMapModel<3, 2> somModel;
+        somModel.map = map;
+        somModel.object = model;
+        somModel.learningRate = 0.05f;
+        somModel.maxSteps = (mode == TrainingMode_Batch) ? opts.epochs : opts.steps;
+        somModel.neighborhood = 0.5f * std::sqrt(2.0f) * opts.mapSize;
+        somModel.bmuSearch = search;
+        somModel.trainingMode = mode;
+        somModel.seed = opts.seed;
+
+        double seconds;
+        {
+            SelfOrganizingMap som(somModel);
+            auto const start = Clock::now();
+            som.ToggleTraining();
+            while (!som.IsDone()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            seconds = Seconds(start);
+        }
+        Report(name, somModel.maxSteps / seconds, unit);
+    }
+
+    void BenchmarkModel(Options const& opts, std::string const& filename)
+    {
+        std::printf("%s\n", filename.c_str());
+
+        VolumetricModelData data;
+        auto start = Clock::now();
+        if (!data.Read(filename)) {
+            log_error("%s", data.GetError().c_str());
+            return;
+        }
+        Report("Read", 1e3 * Seconds(start), "ms");
+
+        glm::ivec3 const res = data.GetResolution();
+        double const gridVoxels = static_cast<double>(res.x) * res.y * res.z;
+
+        start = Clock::now();
+        auto model = std::make_shared<SurfaceVoxels>(data);
+        Report("SurfaceVoxels", gridVoxels / Seconds(start), "voxels/s");
+        Report("  surface voxels", static_cast<double>(model->Voxels().size()), "");
+
+        start = Clock::now();
+        Mesh const mesh = model->GetMesh().GenerateMesh();
+        Report("EditableMesh::GenerateMesh", mesh.positions.size() / 3 / Seconds(start), "triangles/s");
+
+        std::mt19937 rng(opts.seed);
+        Dataset<3> const dataset(model->GetPositions());
+        BenchmarkBMU(opts, dataset, rng);
+
+        auto const& samples = dataset.GetData();
+        BenchmarkTraining(opts, model, ConstructSampledMap(opts.mapSize, samples, rng), TrainingMode_Batch,
+                          BMUSearch_BruteForce, "Batch training", "epochs/s");
+        BenchmarkTraining(opts, model, ConstructSampledMap(opts.mapSize, samples, rng), TrainingMode_Online,
+                          BMUSearch_UniformGrid, "Online training, uniform grid", "steps/s");
+
+        auto map = ConstructSampledMap(opts.mapSize, samples, rng);
+        BenchmarkTraining(opts, model, map, TrainingMode_Online, BMUSearch_BruteForce, "Online training", "steps/s");
+
+        map->GenerateMesh();
+        float progress = 0.0f;
+        start = Clock::now();
+        model->Parameterize(*map, progress).get();
+        Report("Parameterize", model->Voxels().size() / Seconds(start), "voxels/s");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options opts;
+    if (!ParseArguments(argc, argv, opts)) {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    log_set_level(LOG_LEVEL_WARN);
+    std::printf("Kernels: %s, map: %dx%d, seed: %u\n", kernel::InstructionSet(), opts.mapSize, opts.mapSize,
+                opts.seed);
+
+    for (auto const& model : opts.models) {
+        BenchmarkModel(opts, model);
+    }
+
+    for (int n : opts.synthetic) {
+        auto const filename
+            = (std::filesystem::temp_directory_path() / ("flexo-bench-" + std::to_string(n) + ".rvl")).string();
+        WriteSyntheticGrid(filename, n, opts.seed);
+        BenchmarkModel(opts, filename);
+        std::filesystem::remove(filename);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,244 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "ModelImport.hpp"
+#include "SelfOrganizingMap.hpp"
+#include "SelfOrganizingMapModel.hpp"
+#include "assetlib/OBJ/OBJExporter.hpp"
+#include "log/Logger.h"
+#include "object/Map.hpp"
+#include "object/SurfaceVoxels.hpp"
+
+namespace
+{
+    struct Options {
+        std::string input;
+        std::string output;
+        std::string mapOutput;
+        int width = 32;
+        int height = 32;
+        MapFlags flags = MapFlags_CyclicNone;
+        MapInitState initState = MapInitState_Plane;
+        long iterations = -1;
+        float learningRate = 0.05f;
+        float neighborhood = -1.0f;
+        BMUSearch bmuSearch = BMUSearch_BruteForce;
+        TrainingMode trainingMode = TrainingMode_Online;
+        std::uint64_t seed = 5489u;
+        bool mergeFaces = true;
+        int resolution = 128;
+        bool solid = true;
+    };
+
+    void PrintUsage(char const* program)
+    {
+        std::printf("Usage: %s [options] <input.rvl|input.stl|input.obj> <output.obj>\n"
+                    "\n"
+                    "Train a map on the surface voxels of a volumetric model and write the texture-mapped voxels.\n"
+                    "Meshes are voxelized first.\n"
+                    "\n"
+                    "Options:\n"
+                    "  --width <n>          Map width (default: 32)\n"
+                    "  --height <n>         Map height (default: 32)\n"
+                    "  --cyclic-x           Map is cyclic on X\n"
+                    "  --cyclic-y           Map is cyclic on Y\n"
+                    "  --init <state>       Initial state: plane, cylinder or random (default: plane)\n"
+                    "  --iterations <n>     Training steps, or epochs in batch mode (default: 150000, batch: 100)\n"
+                    "  --rate <r>           Initial learning rate (default: 0.05)\n"
+                    "  --radius <r>         Initial neighborhood radius (default: half of the map diagonal)\n"
+                    "  --batch              Train in batch epochs\n"
+                    "  --uniform-grid       Search BMUs with a uniform grid\n"
+                    "  --seed <n>           Seed of the random initial state and the input sampling (default: 5489)\n"
+                    "  --per-face           Write every voxel face separately instead of merging equal neighbours\n"
+                    "  --map-output <file>  Also write the trained map to an OBJ file\n"
+                    "  --resolution <n>     Voxels along the longest side of a mesh (default: 128)\n"
+                    "  --hollow             Voxelize only the surface of a mesh instead of filling it\n"
+                    "  --help               Show this message\n",
+                    program);
+    }
+
+    bool ParseArguments(int argc, char* argv[], Options& opts)
+    {
+        int positional = 0;
+
+        for (int i = 1; i < argc; i++) {
+            char const* arg = argv[i];
+            bool const hasValue = (i + 1 < argc);
+
+            if (std::strcmp(arg, "--help") == 0) {
+                PrintUsage(argv[0]);
+                exit(EXIT_SUCCESS);
+            } else if (std::strcmp(arg, "--width") == 0 && hasValue) {
+                opts.width = std::atoi(argv[++i]);
+            } else if (std::strcmp(arg, "--height") == 0 && hasValue) {
+                opts.height = std::atoi(argv[++i]);
+            } else if (std::strcmp(arg, "--cyclic-x") == 0) {
+                opts.flags |= MapFlags_CyclicX;
+            } else if (std::strcmp(arg, "--cyclic-y") == 0) {
+                opts.flags |= MapFlags_CyclicY;
+            } else if (std::strcmp(arg, "--init") == 0 && hasValue) {
+                std::string const state = argv[++i];
+                if (state == "plane") {
+                    opts.initState = MapInitState_Plane;
+                } else if (state == "cylinder") {
+                    opts.initState = MapInitState_Cylinder;
+                } else if (state == "random") {
+                    opts.initState = MapInitState_Random;
+                } else {
+                    log_error("Unknown initial state: \"%s\"", state.c_str());
+                    return false;
+                }
+            } else if (std::strcmp(arg, "--iterations") == 0 && hasValue) {
+                opts.iterations = std::atol(argv[++i]);
+            } else if (std::strcmp(arg, "--rate") == 0 && hasValue) {
+                opts.learningRate = std::atof(argv[++i]);
+            } else if (std::strcmp(arg, "--radius") == 0 && hasValue) {
+                opts.neighborhood = std::atof(argv[++i]);
+            } else if (std::strcmp(arg, "--batch") == 0) {
+                opts.trainingMode = TrainingMode_Batch;
+            } else if (std::strcmp(arg, "--uniform-grid") == 0) {
+                opts.bmuSearch = BMUSearch_UniformGrid;
+            } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+                opts.seed = std::strtoull(argv[++i], nullptr, 10);
+            } else if (std::strcmp(arg, "--per-face") == 0) {
+                opts.mergeFaces = false;
+            } else if (std::strcmp(arg, "--map-output") == 0 && hasValue) {
+                opts.mapOutput = argv[++i];
+            } else if (std::strcmp(arg, "--resolution") == 0 && hasValue) {
+                opts.resolution = std::atoi(argv[++i]);
+            } else if (std::strcmp(arg, "--hollow") == 0) {
+                opts.solid = false;
+            } else if (arg[0] == '-' && arg[1] == '-') {
+                log_error("Unknown or incomplete option: \"%s\"", arg);
+                return false;
+            } else if (positional == 0) {
+                opts.input = arg;
+                positional++;
+            } else if (positional == 1) {
+                opts.output = arg;
+                positional++;
+            } else {
+                log_error("Unexpected argument: \"%s\"", arg);
+                return false;
+            }
+        }
+
+        if (positional != 2) {
+            log_error("Input and output files are required");
+            return false;
+        }
+
+        if (opts.width < 2 || opts.height < 2) {
+            log_error("The map must be at least 2x2");
+            return false;
+        }
+
+        if (opts.resolution < 1) {
+            log_error("The resolution must be at least 1");
+            return false;
+        }
+
+        // Same defaults as the SOM dialog
+        if (opts.iterations < 0) {
+            opts.iterations = (opts.trainingMode == TrainingMode_Batch) ? 100 : 150000;
+        }
+        if (opts.neighborhood < 0.0f) {
+            float const diagLen = std::sqrt(static_cast<float>(opts.width * opts.width + opts.height * opts.height));
+            opts.neighborhood = 0.5f * diagLen;
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options opts;
+    if (!ParseArguments(argc, argv, opts)) {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    auto const imported = std::chrono::steady_clock::now();
+    std::shared_ptr<SurfaceVoxels> model;
+    {
+        ModelImport import(opts.input, opts.resolution, opts.solid);
+        while (!import.WaitFor(std::chrono::seconds(5))) {
+            log_info("Importing: %.1f%%", import.GetProgress());
+        }
+        model = import.GetResult();
+        if (!model) {
+            log_error("Failed to import \"%s\": %s", opts.input.c_str(), import.GetError().c_str());
+            return EXIT_FAILURE;
+        }
+    }
+    log_info("%zu surface voxels in \"%s\", imported in %.2f s", model->Voxels().size(), opts.input.c_str(),
+             std::chrono::duration<double>(std::chrono::steady_clock::now() - imported).count());
+
+    auto map = ConstructMap(opts.width, opts.height, opts.flags, opts.initState, opts.seed);
+    log_info("Map: (width: %d, height: %d)", opts.width, opts.height);
+
+    SelfOrganizingMapModel<3, 2> somModel;
+    somModel.map = map;
+    somModel.object = model;
+    somModel.learningRate = opts.learningRate;
+    somModel.maxSteps = static_cast<unsigned int>(opts.iterations);
+    somModel.neighborhood = opts.neighborhood;
+    somModel.bmuSearch = opts.bmuSearch;
+    somModel.trainingMode = opts.trainingMode;
+    somModel.seed = opts.seed;
+
+    auto const start = std::chrono::steady_clock::now();
+    {
+        SelfOrganizingMap som(somModel);
+        som.ToggleTraining();
+
+        auto report = start;
+        while (!som.IsDone()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            auto const now = std::chrono::steady_clock::now();
+            if (now - report >= std::chrono::seconds(5)) {
+                log_info("Training: %d / %ld", som.GetIterations(), opts.iterations);
+                report = now;
+            }
+        }
+    }
+    auto const trained = std::chrono::steady_clock::now();
+    log_info("Training finished in %.2f s", std::chrono::duration<double>(trained - start).count());
+
+    map->GenerateMesh();
+
+    float progress = 0.0f;
+    auto status = model->Parameterize(*map, progress);
+    while (status.wait_for(std::chrono::seconds(5)) != std::future_status::ready) {
+        log_info("Parameterizing: %.1f%%", progress);
+    }
+    status.get();
+    model->SetMergeFaces(opts.mergeFaces);
+    model->GenerateMesh();
+    log_info("Parameterization finished in %.2f s",
+             std::chrono::duration<double>(std::chrono::steady_clock::now() - trained).count());
+
+    OBJExporter exporter;
+    if (!exporter.WriteFile(opts.output, model->GetMesh())) {
+        return EXIT_FAILURE;
+    }
+    log_info("Wrote \"%s\"", opts.output.c_str());
+
+    if (!opts.mapOutput.empty()) {
+        if (!exporter.WriteFile(opts.mapOutput, map->GetMesh())) {
+            return EXIT_FAILURE;
+        }
+        log_info("Wrote \"%s\"", opts.mapOutput.c_str());
+    }
+
+    return EXIT_SUCCESS;
+}
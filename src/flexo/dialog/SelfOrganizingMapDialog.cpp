@@ -4,6 +4,8 @@
 #include "SelfOrganizingMap.hpp"
 #include "event/SliderFloatEvent.hpp"
 
+#include <random>
+
 #include <wx/artprov.h>
 #include <wx/bmpcbox.h>
 #include <wx/button.h>
@@ -19,12 +21,16 @@ SelfOrganizingMapDialog::SelfOrganizingMapDialog(wxWindow* parent, std::vector<s
     , m_maxIterations(0)
     , m_leanringRate(0.0f)
     , m_neighborhood(0.0f)
+    , m_bmuSearch(BMUSearch_BruteForce)
+    , m_trainingMode(TrainingMode_Online)
+    , m_seed(0)
     , m_project(project)
 {
-    wxTextCtrl *labelModel, *labelMap, *labelIter, *labelRate, *labelRadius;
-    wxTextCtrl *textIter, *textRate;
+    wxTextCtrl *labelModel, *labelMap, *labelIter, *labelRate, *labelRadius, *labelSearch, *labelMode, *labelSeed;
+    wxTextCtrl *textIter, *textRate, *textSeed;
     wxStaticText* textRadius;
     wxSlider* sliderRadius;
+    wxCheckBox *checkGrid, *checkBatch;
     wxBitmapComboBox *comboModel, *comboMap;
     wxStdDialogButtonSizer* stdbtn;
 
@@ -41,11 +47,20 @@ SelfOrganizingMapDialog::SelfOrganizingMapDialog(wxWindow* parent, std::vector<s
                                wxBORDER_NONE | wxTE_RIGHT | wxTE_READONLY);
     labelRadius = new wxTextCtrl(this, wxID_ANY, "Neighborhood", wxDefaultPosition, wxDefaultSize,
                                  wxBORDER_NONE | wxTE_RIGHT | wxTE_READONLY);
+    labelSearch = new wxTextCtrl(this, wxID_ANY, "BMU Search", wxDefaultPosition, wxDefaultSize,
+                                 wxBORDER_NONE | wxTE_RIGHT | wxTE_READONLY);
+    labelMode = new wxTextCtrl(this, wxID_ANY, "Training", wxDefaultPosition, wxDefaultSize,
+                               wxBORDER_NONE | wxTE_RIGHT | wxTE_READONLY);
+    labelSeed = new wxTextCtrl(this, wxID_ANY, "Seed", wxDefaultPosition, wxDefaultSize,
+                               wxBORDER_NONE | wxTE_RIGHT | wxTE_READONLY);
 
     textIter = new wxTextCtrl(this, wxID_ANY, "", wxDefaultPosition, wxDefaultSize, wxTE_CENTER);
     textRate = new wxTextCtrl(this, wxID_ANY, "", wxDefaultPosition, wxDefaultSize, wxTE_CENTER);
+    textSeed = new wxTextCtrl(this, wxID_ANY, "", wxDefaultPosition, wxDefaultSize, wxTE_CENTER);
     sliderRadius = new wxSlider(this, wxID_ANY, 0, 0, 0);
     textRadius = new wxStaticText(this, wxID_ANY, wxString::Format("%.2f", 0.00f));
+    checkGrid = new wxCheckBox(this, wxID_ANY, "Uniform grid");
+    checkBatch = new wxCheckBox(this, wxID_ANY, "Batch epochs");
 
     stdbtn = CreateStdDialogButtonSizer(wxOK | wxCANCEL);
 
@@ -56,17 +71,27 @@ SelfOrganizingMapDialog::SelfOrganizingMapDialog(wxWindow* parent, std::vector<s
     labelIter->SetBackgroundColour(bg);
     labelRate->SetBackgroundColour(bg);
     labelRadius->SetBackgroundColour(bg);
+    labelSearch->SetBackgroundColour(bg);
+    labelMode->SetBackgroundColour(bg);
+    labelSeed->SetBackgroundColour(bg);
     labelModel->SetCanFocus(false);
     labelMap->SetCanFocus(false);
     labelIter->SetCanFocus(false);
     labelRate->SetCanFocus(false);
     labelRadius->SetCanFocus(false);
+    labelSearch->SetCanFocus(false);
+    labelMode->SetCanFocus(false);
+    labelSeed->SetCanFocus(false);
 
     // Default values
     m_maxIterations = 150000;
     m_leanringRate = 0.05f;
+    m_seed = std::random_device {}();
     *textIter << m_maxIterations;
     *textRate << m_leanringRate;
+    *textSeed << m_seed;
+    checkGrid->SetValue(m_bmuSearch == BMUSearch_UniformGrid);
+    checkBatch->SetValue(m_trainingMode == TrainingMode_Batch);
 
     for (auto id : mapIDs) {
         comboMap->Append(id, wxArtProvider::GetBitmap(wxART_WX_LOGO, wxART_OTHER, wxSize(16, 16)));
@@ -76,19 +101,24 @@ SelfOrganizingMapDialog::SelfOrganizingMapDialog(wxWindow* parent, std::vector<s
         comboModel->Append(id, wxArtProvider::GetBitmap(wxART_WX_LOGO, wxART_OTHER, wxSize(16, 16)));
     }
 
+    wxIntegerValidator<unsigned long long> validSeed;
     wxIntegerValidator<int> validIter;
     wxFloatingPointValidator<float> validRate(6, nullptr);
     validIter.SetMin(0);
     validRate.SetRange(0.0f, 1.0f);
     textIter->SetValidator(validIter);
     textRate->SetValidator(validRate);
+    textSeed->SetValidator(validSeed);
 
     // Binding
     textIter->Bind(wxEVT_TEXT, &SelfOrganizingMapDialog::OnMaxIterationChanged, this);
     textRate->Bind(wxEVT_TEXT, &SelfOrganizingMapDialog::OnInitialRateChanged, this);
+    textSeed->Bind(wxEVT_TEXT, &SelfOrganizingMapDialog::OnSeedChanged, this);
     comboModel->Bind(wxEVT_COMBOBOX, &SelfOrganizingMapDialog::OnModelSelected, this);
     comboMap->Bind(wxEVT_COMBOBOX, &SelfOrganizingMapDialog::OnMapSelected, this);
     sliderRadius->Bind(wxEVT_SLIDER, &SelfOrganizingMapDialog::OnInitialNeighborhoodChanged, this);
+    checkGrid->Bind(wxEVT_CHECKBOX, &SelfOrganizingMapDialog::OnBMUSearchToggled, this);
+    checkBatch->Bind(wxEVT_CHECKBOX, &SelfOrganizingMapDialog::OnTrainingModeToggled, this);
 
     auto* btnOK = stdbtn->GetAffirmativeButton();
     btnOK->Bind(wxEVT_UPDATE_UI, [this](wxUpdateUIEvent& event) { event.Enable(m_map.lock() && m_object.lock()); });
@@ -96,6 +126,7 @@ SelfOrganizingMapDialog::SelfOrganizingMapDialog(wxWindow* parent, std::vector<s
     // Set members
     m_sliderRadius = sliderRadius;
     m_textRadius = textRadius;
+    m_textIter = textIter;
 
     // Layout
     wxSizer* sizerSlider = new wxBoxSizer(wxHORIZONTAL);
@@ -116,6 +147,12 @@ SelfOrganizingMapDialog::SelfOrganizingMapDialog(wxWindow* parent, std::vector<s
     sizerSlider->Add(textRadius, wxSizerFlags().Expand().Proportion(1));
     grid->Add(labelRadius, wxSizerFlags().Expand().Proportion(4));
     grid->Add(sizerSlider, wxSizerFlags().Expand().Proportion(5));
+    grid->Add(labelSearch, wxSizerFlags().Expand().Proportion(4));
+    grid->Add(checkGrid, wxSizerFlags().Expand().Proportion(5));
+    grid->Add(labelMode, wxSizerFlags().Expand().Proportion(4));
+    grid->Add(checkBatch, wxSizerFlags().Expand().Proportion(5));
+    grid->Add(labelSeed, wxSizerFlags().Expand().Proportion(4));
+    grid->Add(textSeed, wxSizerFlags().Expand().Proportion(5));
 
     m_topLayout = new wxBoxSizer(wxVERTICAL);
     m_topLayout->Add(grid, wxSizerFlags().Expand().Border(wxALL, 16));
@@ -136,6 +173,9 @@ SelfOrganizingMapModel<3, 2> SelfOrganizingMapDialog::GetConfig() const
     model.learningRate = m_leanringRate;
     model.maxSteps = m_maxIterations;
     model.neighborhood = m_neighborhood;
+    model.bmuSearch = m_bmuSearch;
+    model.trainingMode = m_trainingMode;
+    model.seed = m_seed;
 
     return model;
 }
@@ -177,6 +217,14 @@ void SelfOrganizingMapDialog::OnInitialRateChanged(wxCommandEvent& event)
     }
 }
 
+void SelfOrganizingMapDialog::OnSeedChanged(wxCommandEvent& event)
+{
+    unsigned long long tmp;
+    if (event.GetString().ToULongLong(&tmp)) {
+        m_seed = tmp;
+    }
+}
+
 void SelfOrganizingMapDialog::OnInitialNeighborhoodChanged(wxCommandEvent& event)
 {
     float const value = event.GetInt() * 0.01f;
@@ -184,6 +232,18 @@ void SelfOrganizingMapDialog::OnInitialNeighborhoodChanged(wxCommandEvent& event
     m_neighborhood = value;
 }
 
+void SelfOrganizingMapDialog::OnBMUSearchToggled(wxCommandEvent& event)
+{
+    m_bmuSearch = event.IsChecked() ? BMUSearch_UniformGrid : BMUSearch_BruteForce;
+}
+
+void SelfOrganizingMapDialog::OnTrainingModeToggled(wxCommandEvent& event)
+{
+    // In batch mode every iteration is a whole pass over the dataset.
+    m_trainingMode = event.IsChecked() ? TrainingMode_Batch : TrainingMode_Online;
+    m_textIter->SetValue(wxString() << (m_trainingMode == TrainingMode_Batch ? 100 : 150000));
+}
+
 void SelfOrganizingMapDialog::SetupNeighborhoodRadiusSlider(float maxValue, float value)
 {
     float const scale = 100.0f;
@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <utility>
 
 #include "Drawable.hpp"
 #include "gfx/Graphics.hpp"
+#include "gfx/bindable/Texture2D.hpp"
 #include "gfx/bindable/UniformBuffer.hpp"
 
 Drawable::Drawable()
@@ -34,6 +36,16 @@ void Drawable::AddBindStep(BindStep step)
     m_steps.push_back(std::move(step));
 }
 
+void Drawable::ChangeTexture(std::shared_ptr<Bind::Texture2D> texture)
+{
+    bool (*const FindTexture)(std::shared_ptr<Bind::Bindable>&)
+        = [](std::shared_ptr<Bind::Bindable>& bind) { return (dynamic_cast<Bind::Texture2D*>(bind.get()) != nullptr); };
+
+    auto& bindings = m_steps.front().bindables;
+    bindings.erase(std::remove_if(bindings.begin(), bindings.end(), FindTexture), bindings.end());
+    m_steps.front().AddBindable(std::move(texture));
+}
+
 void Drawable::Submit(Renderer& renderer)
 {
     for (auto& step : m_steps) {
@@ -12,12 +12,12 @@ Overlays::Overlays(Graphics& gfx)
     auto axisX = EditableMesh();
     axisX.positions.emplace_back(1.0f, 0.0f, 0.0f);
     axisX.positions.emplace_back(-1.0f, 0.0f, 0.0f);
-    axisX.faces.push_back({ 0, 1 });
+    axisX.faces.PushBack({ 0, 1 });
 
     auto axisY = EditableMesh();
     axisY.positions.emplace_back(0.0f, 1.0f, 0.0f);
     axisY.positions.emplace_back(0.0f, -1.0f, 0.0f);
-    axisY.faces.push_back({ 0, 1 });
+    axisY.faces.PushBack({ 0, 1 });
 
     TransformStack ts;
     ts.PushScale(90.0f, 90.0f, 1.0f);
@@ -57,11 +57,16 @@ SolidDrawable::SolidDrawable(Graphics& gfx, Mesh const& mesh)
 
     std::vector<GLWRInputElementDesc> inputs = {
         { "position", GLWRFormat_Float3, 0, layout.GetOffset("Position"), GLWRInputClassification_PerVertex, 0 },
-        { "normal", GLWRFormat_Float3, 0, layout.GetOffset("Normal"), GLWRInputClassification_PerVertex, 0 },
     };
+    if (mesh.HasNormals()) {
+        inputs.push_back(
+            { "normal", GLWRFormat_Float3, 0, layout.GetOffset("Normal"), GLWRInputClassification_PerVertex, 0 });
+    }
 
     AddBind(std::make_shared<Bind::Primitive>(gfx, GL_TRIANGLES));
-    AddBind(std::make_shared<Bind::VertexBuffer>(gfx, vertices));
+    m_vertexBuffer = std::make_shared<Bind::VertexBuffer>(gfx, vertices);
+    AddBind(m_vertexBuffer);
+    AddBind(std::make_shared<Bind::IndexBuffer>(gfx, GenIndexArray(mesh)));
 
     BindStep step;
 
@@ -77,13 +82,23 @@ SolidDrawable::SolidDrawable(Graphics& gfx, Mesh const& mesh)
 
     AddBindStep(step);
 
-    m_vertCount = vertices.GetCount();
+    m_indexCount = mesh.HasFaces() ? 3 * mesh.faces.size() : vertices.GetCount();
 }
 
 SolidDrawable::~SolidDrawable()
 {
 }
 
+bool SolidDrawable::UpdateVertices(Graphics& gfx, Mesh const& mesh)
+{
+    if (mesh.positions.size() != m_vertexBuffer->GetCount()
+        || GenVertexLayout(mesh).GetSize() != m_vertexBuffer->GetLayout().GetSize()) {
+        return false;
+    }
+    m_vertexBuffer->Update(gfx, [&mesh](VertexWriter const& writer) { WriteVertices(mesh, writer); });
+    return true;
+}
+
 void SolidDrawable::Update(Graphics& gfx)
 {
     m_ubs["transform"].Assign("model", m_transform);
@@ -1,7 +1,6 @@
-#include <algorithm>
-
 #include "TexturedDrawable.hpp"
 #include "gfx/BindStep.hpp"
+#include "gfx/bindable/IndexBuffer.hpp"
 #include "gfx/bindable/InputLayout.hpp"
 #include "gfx/bindable/Primitive.hpp"
 #include "gfx/bindable/RasterizerState.hpp"
@@ -18,7 +17,7 @@ TexturedDrawable::TexturedDrawable(Graphics& gfx, Mesh const& mesh, std::shared_
     samplerDesc.coordinateS = GLWRTextureCoordinatesMode_Wrap;
     samplerDesc.coordinateT = GLWRTextureCoordinatesMode_Wrap;
     samplerDesc.coordinateR = GLWRTextureCoordinatesMode_Wrap;
-    samplerDesc.filter = GLWRFilter_MinMagNearest_MipNearest;
+    samplerDesc.filter = GLWRFilter_MinMagLinear_MipLinear;
 
     m_ubs["transform"].AddElement(UniformBlock::Type::mat4, "model");
     m_ubs["transform"].AddElement(UniformBlock::Type::mat4, "viewProj");
@@ -61,12 +60,17 @@ TexturedDrawable::TexturedDrawable(Graphics& gfx, Mesh const& mesh, std::shared_
 
     std::vector<GLWRInputElementDesc> inputs = {
         { "position", GLWRFormat_Float3, 0, layout.GetOffset("Position"), GLWRInputClassification_PerVertex, 0 },
-        { "normal", GLWRFormat_Float3, 0, layout.GetOffset("Normal"), GLWRInputClassification_PerVertex, 0 },
         { "textureCoord", GLWRFormat_Float2, 0, layout.GetOffset("TexCoord"), GLWRInputClassification_PerVertex, 0 },
     };
+    if (mesh.HasNormals()) {
+        inputs.push_back(
+            { "normal", GLWRFormat_Float3, 0, layout.GetOffset("Normal"), GLWRInputClassification_PerVertex, 0 });
+    }
 
     AddBind(std::make_shared<Bind::Primitive>(gfx, GL_TRIANGLES));
-    AddBind(std::make_shared<Bind::VertexBuffer>(gfx, vertices));
+    m_vertexBuffer = std::make_shared<Bind::VertexBuffer>(gfx, vertices);
+    AddBind(m_vertexBuffer);
+    AddBind(std::make_shared<Bind::IndexBuffer>(gfx, GenIndexArray(mesh)));
 
     BindStep step;
 
@@ -84,22 +88,21 @@ TexturedDrawable::TexturedDrawable(Graphics& gfx, Mesh const& mesh, std::shared_
 
     AddBindStep(step);
 
-    m_vertCount = vertices.GetCount();
+    m_indexCount = mesh.HasFaces() ? 3 * mesh.faces.size() : vertices.GetCount();
 }
 
 TexturedDrawable::~TexturedDrawable()
 {
 }
 
-// FIXME
-void TexturedDrawable::ChangeTexture(std::shared_ptr<Bind::Texture2D> texture)
+bool TexturedDrawable::UpdateVertices(Graphics& gfx, Mesh const& mesh)
 {
-    bool (*const FindTexture)(std::shared_ptr<Bind::Bindable>&)
-        = [](std::shared_ptr<Bind::Bindable>& bind) { return (dynamic_cast<Bind::Texture2D*>(bind.get()) != nullptr); };
-
-    auto& bindings = m_steps.front().bindables;
-    bindings.erase(std::remove_if(bindings.begin(), bindings.end(), FindTexture), bindings.end());
-    m_steps.front().AddBindable(texture);
+    if (mesh.positions.size() != m_vertexBuffer->GetCount()
+        || GenVertexLayout(mesh).GetSize() != m_vertexBuffer->GetLayout().GetSize()) {
+        return false;
+    }
+    m_vertexBuffer->Update(gfx, [&mesh](VertexWriter const& writer) { WriteVertices(mesh, writer); });
+    return true;
 }
 
 void TexturedDrawable::Update(Graphics& gfx)
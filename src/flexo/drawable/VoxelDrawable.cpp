@@ -0,0 +1,123 @@
+#include <vector>
+
+#include "VoxelDrawable.hpp"
+#include "gfx/BindStep.hpp"
+#include "gfx/bindable/InputLayout.hpp"
+#include "gfx/bindable/Primitive.hpp"
+#include "gfx/bindable/RasterizerState.hpp"
+#include "gfx/bindable/Sampler.hpp"
+#include "gfx/bindable/UniformBuffer.hpp"
+#include "gfx/bindable/program/FragmentShaderProgram.hpp"
+#include "gfx/bindable/program/VertexShaderProgram.hpp"
+#include "ResourcePath.hpp"
+
+VoxelDrawable::VoxelDrawable(Graphics& gfx, std::shared_ptr<Bind::VertexBuffer> instances, glm::vec3 scale,
+                             std::shared_ptr<Bind::Texture2D> texture)
+{
+    GLWRSamplerDesc samplerDesc;
+    samplerDesc.coordinateS = GLWRTextureCoordinatesMode_Wrap;
+    samplerDesc.coordinateT = GLWRTextureCoordinatesMode_Wrap;
+    samplerDesc.coordinateR = GLWRTextureCoordinatesMode_Wrap;
+    samplerDesc.filter = GLWRFilter_MinMagLinear_MipLinear;
+
+    m_ubs["transform"].AddElement(UniformBlock::Type::mat4, "model");
+    m_ubs["transform"].AddElement(UniformBlock::Type::mat4, "viewProj");
+    m_ubs["light"].AddElement(UniformBlock::Type::vec3f32, "position");
+    m_ubs["light"].AddElement(UniformBlock::Type::vec3f32, "ambient");
+    m_ubs["light"].AddElement(UniformBlock::Type::vec3f32, "diffusion");
+    m_ubs["light"].AddElement(UniformBlock::Type::vec3f32, "specular");
+    m_ubs["material"].AddElement(UniformBlock::Type::vec3f32, "ambient");
+    m_ubs["material"].AddElement(UniformBlock::Type::vec3f32, "diffusion");
+    m_ubs["material"].AddElement(UniformBlock::Type::vec3f32, "specular");
+    m_ubs["material"].AddElement(UniformBlock::Type::f32, "shininess");
+    m_ubs["viewPos"].AddElement(UniformBlock::Type::vec3f32, "viewPos");
+    m_ubs["voxel"].AddElement(UniformBlock::Type::vec3f32, "scale");
+
+    m_ubs["transform"].FinalizeLayout();
+    m_ubs["light"].FinalizeLayout();
+    m_ubs["material"].FinalizeLayout();
+    m_ubs["viewPos"].FinalizeLayout();
+    m_ubs["voxel"].FinalizeLayout();
+
+    m_ubs["transform"].Assign("model", m_transform);
+    m_ubs["transform"].Assign("viewProj", gfx.GetViewProjectionMatrix());
+
+    auto const& cam = gfx.GetCamera();
+    m_ubs["light"].Assign("position", cam.position + 3.0f * (-cam.basis.sideway + cam.basis.up));
+    m_ubs["light"].Assign("ambient", glm::vec3(0.8f, 0.8f, 0.8f));
+    m_ubs["light"].Assign("diffusion", glm::vec3(0.8f, 0.8f, 0.8f));
+    m_ubs["light"].Assign("specular", glm::vec3(0.8f, 0.8f, 0.8f));
+    m_ubs["material"].Assign("ambient", glm::vec3(0.3f, 0.3f, 0.3f));
+    m_ubs["material"].Assign("diffusion", glm::vec3(0.6f, 0.6f, 0.6f));
+    m_ubs["material"].Assign("specular", glm::vec3(0.3f, 0.3f, 0.3f));
+    m_ubs["material"].Assign("shininess", 256.0f);
+    m_ubs["viewPos"].Assign("viewPos", gfx.GetCameraPosition());
+    m_ubs["voxel"].Assign("scale", scale);
+
+    m_ubs["transform"].SetBIndex(0);
+    m_ubs["light"].SetBIndex(1);
+    m_ubs["material"].SetBIndex(2);
+    m_ubs["viewPos"].SetBIndex(3);
+    m_ubs["voxel"].SetBIndex(4);
+
+    VertexLayout const layout = GetInstanceLayout();
+
+    std::vector<GLWRInputElementDesc> inputs = {
+        { "instancePosition", GLWRFormat_Float3, 0, layout.GetOffset("Position"), GLWRInputClassification_PerInstance,
+          1 },
+        { "instanceTextureCoord", GLWRFormat_Float2, 0, layout.GetOffset("TexCoord"),
+          GLWRInputClassification_PerInstance, 1 },
+        { "instanceVisibility", GLWRFormat_Uint, 0, layout.GetOffset("Visibility"), GLWRInputClassification_PerInstance,
+          1 },
+    };
+
+    AddBind(std::make_shared<Bind::Primitive>(gfx, GL_TRIANGLES));
+    AddBind(instances);
+
+    BindStep step;
+
+    auto vs = std::make_shared<Bind::VertexShaderProgram>(gfx, ResourcePath::GetOpenGLShaderFile("VoxelDrawable.vert"));
+    step.AddBindable(vs);
+    step.AddBindable(std::make_shared<Bind::FragmentShaderProgram>(gfx, ResourcePath::GetOpenGLShaderFile("TexturedDrawable.frag")));
+    step.AddBindable(std::make_shared<Bind::InputLayout>(gfx, inputs, vs.get()));
+    for (auto const& [id, ub] : m_ubs) {
+        step.AddBindable(std::make_shared<Bind::UniformBuffer>(gfx, ub, id));
+    }
+    step.AddBindable(texture);
+    step.AddBindable(std::make_shared<Bind::Sampler>(gfx, samplerDesc, 0));
+    step.AddBindable(
+        std::make_shared<Bind::RasterizerState>(gfx, GLWRRasterizerDesc { GLWRFillMode_Solid, GLWRCullMode_None }));
+
+    AddBindStep(step);
+
+    m_vertexCountPerInstance = 36;
+    m_instanceCount = instances->GetCount();
+}
+
+VoxelDrawable::~VoxelDrawable()
+{
+}
+
+VertexLayout VoxelDrawable::GetInstanceLayout()
+{
+    VertexLayout layout;
+    layout.AddAttrib("Position", VertexLayout::AttribFormat::Float3);
+    layout.AddAttrib("TexCoord", VertexLayout::AttribFormat::Float2);
+    layout.AddAttrib("Visibility", VertexLayout::AttribFormat::Uint);
+    return layout;
+}
+
+void VoxelDrawable::SetVoxelScale(glm::vec3 scale)
+{
+    m_ubs["voxel"].Assign("scale", scale);
+}
+
+void VoxelDrawable::Update(Graphics& gfx)
+{
+    m_ubs["transform"].Assign("model", m_transform);
+    m_ubs["transform"].Assign("viewProj", gfx.GetViewProjectionMatrix());
+    m_ubs["viewPos"].Assign("viewPos", gfx.GetCameraPosition());
+
+    auto const& cam = gfx.GetCamera();
+    m_ubs["light"].Assign("position", cam.position + 3.0f * (-cam.basis.sideway + cam.basis.up));
+}
@@ -17,6 +17,19 @@
 #include "gfx/bindable/program/VertexShaderProgram.hpp"
 #include "ResourcePath.hpp"
 
+namespace
+{
+    VertexArray GenPositionArray(std::vector<glm::vec3> const& positions)
+    {
+        VertexLayout layout;
+        layout.AddAttrib("Position", VertexLayout::AttribFormat::Float3);
+
+        VertexArray vertices(layout, positions.size());
+        vertices.GetWriter().Fill("Position", positions);
+        return vertices;
+    }
+}
+
 WireDrawable::WireDrawable(Graphics& gfx, Wireframe const& wireframe)
 {
     std::vector<unsigned int> indices;
@@ -38,14 +51,7 @@ WireDrawable::WireDrawable(Graphics& gfx, Wireframe const& wireframe)
     m_ubs["transform"].Assign("viewProj", gfx.GetViewProjectionMatrix());
     m_ubs["color"].Assign("color", glm::vec3(0.7f, 0.7f, 0.7f));
 
-    VertexLayout layout;
-    layout.AddAttrib("Position", VertexLayout::AttribFormat::Float3);
-
-    VertexArray vertices(layout);
-    for (auto const& p : wireframe.positions) {
-        vertices.Assign("Position", p);
-        vertices.PushBack();
-    }
+    VertexArray vertices = GenPositionArray(wireframe.positions);
 
     std::vector<GLWRInputElementDesc> inputs = {
         { "position", GLWRFormat_Float3, 0, vertices.GetLayout().GetOffset("Position"),
@@ -53,7 +59,8 @@ WireDrawable::WireDrawable(Graphics& gfx, Wireframe const& wireframe)
     };
 
     AddBind(std::make_shared<Bind::Primitive>(gfx, GL_LINES));
-    AddBind(std::make_shared<Bind::VertexBuffer>(gfx, vertices));
+    m_vertexBuffer = std::make_shared<Bind::VertexBuffer>(gfx, vertices);
+    AddBind(m_vertexBuffer);
     AddBind(std::make_shared<Bind::IndexBuffer>(gfx, indices));
 
     BindStep step;
@@ -80,6 +87,15 @@ void WireDrawable::SetColor(Color color)
     m_ubs["color"].Assign("color", color);
 }
 
+bool WireDrawable::UpdatePositions(Graphics& gfx, std::vector<glm::vec3> const& positions)
+{
+    if (positions.size() != m_vertexBuffer->GetCount()) {
+        return false;
+    }
+    m_vertexBuffer->Update(gfx, [&positions](VertexWriter const& writer) { writer.Fill("Position", positions); });
+    return true;
+}
+
 void WireDrawable::Update(Graphics& gfx)
 {
     m_ubs["transform"].Assign("model", m_transform);
@@ -17,6 +17,7 @@ class Graphics;
 namespace Bind
 {
     class Bindable;
+    class Texture2D;
 }
 
 class Drawable : public DrawableBase
@@ -29,6 +30,11 @@ public:
     void Submit(Renderer& renderer);
     void SetTransform(glm::mat4 transform);
     void AddBindStep(BindStep step);
+
+    /**
+     * Replace the textures bound by the first step with the given one
+     */
+    void ChangeTexture(std::shared_ptr<Bind::Texture2D> texture);
     void UpdateUniformBuffers(Graphics& gfx) const;
     void SetVisible(bool visible);
     bool IsVisible() const;
@@ -13,7 +13,7 @@ public:
     virtual ~InstancedDrawable() = default;
     virtual void Draw(Graphics& gfx) const override;
 
-private:
+protected:
     unsigned int m_vertexCountPerInstance;
     unsigned int m_instanceCount;
 };
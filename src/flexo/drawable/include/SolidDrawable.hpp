@@ -1,17 +1,33 @@
 #ifndef SOLID_DRAWABLE_H
 #define SOLID_DRAWABLE_H
 
-#include "Drawable.hpp"
+#include "IndexedDrawable.hpp"
 #include "gfx/Mesh.hpp"
 #include "gfx/Graphics.hpp"
 #include "gfx/UniformBlock.hpp"
+#include "gfx/bindable/VertexBuffer.hpp"
 
-class SolidDrawable : public Drawable
+/**
+ * Lit triangles drawn through an index buffer
+ *
+ * Meshes with faces share their vertices between triangles. Without normals, every triangle is shaded flat with the
+ * normal derived from its screen-space position derivatives.
+ */
+class SolidDrawable : public IndexedDrawable
 {
 public:
     SolidDrawable(Graphics& gfx, Mesh const& mesh);
     ~SolidDrawable() override;
+    /**
+     * Stream new vertex data of the same mesh topology into the existing vertex buffer
+     *
+     * @return False if the vertex count differs and the drawable has to be recreated instead
+     */
+    bool UpdateVertices(Graphics& gfx, Mesh const& mesh);
     virtual void Update(Graphics& gfx) override;
+
+private:
+    std::shared_ptr<Bind::VertexBuffer> m_vertexBuffer;
 };
 
 #endif
@@ -3,19 +3,31 @@
 
 #include <unordered_map>
 
-#include "Drawable.hpp"
+#include "IndexedDrawable.hpp"
 #include "gfx/Mesh.hpp"
 #include "gfx/Graphics.hpp"
 #include "gfx/UniformBlock.hpp"
+#include "gfx/bindable/VertexBuffer.hpp"
 #include "gfx/bindable/Texture2D.hpp"
 
-class TexturedDrawable : public Drawable
+/**
+ * SolidDrawable with the texture coordinates of the mesh sampling a texture
+ */
+class TexturedDrawable : public IndexedDrawable
 {
 public:
     TexturedDrawable(Graphics& gfx, Mesh const& mesh, std::shared_ptr<Bind::Texture2D> texture);
     ~TexturedDrawable() override;
-    void ChangeTexture(std::shared_ptr<Bind::Texture2D> texture);
+    /**
+     * Stream new vertex data of the same mesh topology into the existing vertex buffer
+     *
+     * @return False if the vertex count differs and the drawable has to be recreated instead
+     */
+    bool UpdateVertices(Graphics& gfx, Mesh const& mesh);
     virtual void Update(Graphics& gfx) override;
+
+private:
+    std::shared_ptr<Bind::VertexBuffer> m_vertexBuffer;
 };
 
 #endif
@@ -0,0 +1,33 @@
+#ifndef VOXEL_DRAWABLE_H
+#define VOXEL_DRAWABLE_H
+
+#include <memory>
+
+#include <glm/glm.hpp>
+
+#include "InstancedDrawable.hpp"
+#include "gfx/Graphics.hpp"
+#include "gfx/VertexLayout.hpp"
+#include "gfx/bindable/Texture2D.hpp"
+#include "gfx/bindable/VertexBuffer.hpp"
+
+/**
+ * Textured voxels drawn as instances of a unit cube
+ *
+ * Every voxel is one record of the instance buffer with the attributes "Position", "TexCoord" and "Visibility", the
+ * last being the VoxelVis mask. The cube itself has no vertex buffer: the vertex shader builds its 36 vertices from
+ * the vertex index and drops the faces that are not visible. The instance buffer can be shared by several drawables,
+ * e.g. a solid and a textured one, so that a single upload refreshes both.
+ */
+class VoxelDrawable : public InstancedDrawable
+{
+public:
+    VoxelDrawable(Graphics& gfx, std::shared_ptr<Bind::VertexBuffer> instances, glm::vec3 scale,
+                  std::shared_ptr<Bind::Texture2D> texture);
+    ~VoxelDrawable() override;
+    static VertexLayout GetInstanceLayout();
+    void SetVoxelScale(glm::vec3 scale);
+    virtual void Update(Graphics& gfx) override;
+};
+
+#endif
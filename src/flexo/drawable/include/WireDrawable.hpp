@@ -1,19 +1,38 @@
 #ifndef WIRE_DRAWABLE_H
 #define WIRE_DRAWABLE_H
 
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
 #include "IndexedDrawable.hpp"
 #include "Colors.hpp"
 
 class Graphics;
 struct Wireframe;
 
+namespace Bind
+{
+    class VertexBuffer;
+}
+
 class WireDrawable : public IndexedDrawable
 {
 public:
     WireDrawable(Graphics& gfx, Wireframe const& wireframe);
     ~WireDrawable() override;
     void SetColor(Color color);
+    /**
+     * Stream new vertex positions of the same wireframe topology into the existing vertex buffer
+     *
+     * @return False if the vertex count differs and the drawable has to be recreated instead
+     */
+    bool UpdatePositions(Graphics& gfx, std::vector<glm::vec3> const& positions);
     virtual void Update(Graphics& gfx) override;
+
+private:
+    std::shared_ptr<Bind::VertexBuffer> m_vertexBuffer;
 };
 
 #endif
@@ -1,5 +1,3 @@
-#include <unordered_map>
-
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "gfx/EditableMesh.hpp"
@@ -87,7 +85,7 @@ EditableMesh ConstructUVSphere(int numSegments, int numRings, float radius)
         i1 = 0; // zenith
         i2 = (j % numSegments) + 1;
         i3 = (j + 1) % numSegments + 1;
-        mesh.faces.push_back({ i1, i2, i3 });
+        mesh.faces.PushBack({ i1, i2, i3 });
     }
 
     // The last ring (bottom)
@@ -98,7 +96,7 @@ EditableMesh ConstructUVSphere(int numSegments, int numRings, float radius)
         i1 = (last - numSegments) + ((j + 1) % numSegments);
         i2 = (last - numSegments) + (j % numSegments);
         i3 = last;
-        mesh.faces.push_back({ i1, i2, i3 });
+        mesh.faces.PushBack({ i1, i2, i3 });
     }
 
     // Vertices for rings without the first one
@@ -127,7 +125,7 @@ EditableMesh ConstructUVSphere(int numSegments, int numRings, float radius)
             i2 = 1 + ((i + 1) * numSegments + (j % numSegments));
             i3 = 1 + ((i + 1) * numSegments + ((j + 1) % numSegments));
             i4 = 1 + (i * numSegments + ((j + 1) % numSegments));
-            mesh.faces.push_back({ i1, i2, i3, i4 });
+            mesh.faces.PushBack({ i1, i2, i3, i4 });
         }
     }
 
@@ -165,7 +163,7 @@ EditableMesh ConstructTorus(int majorSeg, int minorSeg, float majorRad, float mi
                 i2 = ((i + 1) % majorSeg) * minorSeg + (j + k) % minorSeg;
                 i3 = ((i + 1) % majorSeg) * minorSeg + (j + 1 + k) % minorSeg;
                 i4 = (i % majorSeg) * minorSeg + (j + 1 + k) % minorSeg;
-                mesh.faces.push_back({ i1, i2, i3, i4 });
+                mesh.faces.PushBack({ i1, i2, i3, i4 });
             }
         }
     }
@@ -188,6 +186,7 @@ EditableMesh ConstructGrid(int numXDiv, int numYDiv, float size)
         }
     }
 
+    mesh.faces.Reserve((numYDiv - 1) * (numXDiv - 1), 4 * (numYDiv - 1) * (numXDiv - 1));
     for (int y = 0; y < numYDiv - 1; y++) {
         for (int x = 0; x < numXDiv - 1; x++) {
             unsigned int index = y * numXDiv + x;
@@ -197,7 +196,7 @@ EditableMesh ConstructGrid(int numXDiv, int numYDiv, float size)
             i2 = index + 1;
             i3 = index + numXDiv + 1;
             i4 = index + numXDiv;
-            mesh.faces.push_back({ i1, i2, i3, i4 });
+            mesh.faces.PushBack({ i1, i2, i3, i4 });
         }
     }
 
@@ -221,8 +220,8 @@ EditableMesh ConstructIntervaledGrid(int numCell, int numBlock, float size)
             mesh.positions.emplace_back(-1.0f + (j + 1 + begin) * cellSize, +1.0f, 0.0f);
             mesh.positions.emplace_back(-1.0f + (j + 1 + begin) * cellSize, -1.0f, 0.0f);
 
-            mesh.faces.push_back({ index + 0, index + 1 });
-            mesh.faces.push_back({ index + 2, index + 3 });
+            mesh.faces.PushBack({ index + 0, index + 1 });
+            mesh.faces.PushBack({ index + 2, index + 3 });
             index += 4;
         }
         begin += blkSize;
@@ -232,26 +231,15 @@ EditableMesh ConstructIntervaledGrid(int numCell, int numBlock, float size)
 
 std::vector<TriangularFace> EditableMesh::GenerateTriangularFaces() const
 {
-    using VertexCount = unsigned int;
-    using ListOfTriangles = std::vector<TriangularFace>;
-    static std::unordered_map<VertexCount, ListOfTriangles> cache;
-
-    ListOfTriangles triangles;
+    std::vector<TriangularFace> triangles;
+    if (faces.IndexCount() > 2 * faces.Size()) {
+        triangles.reserve(faces.IndexCount() - 2 * faces.Size());
+    }
 
-    for (Face const& face : faces) {
-        VertexCount count = face.size();
+    for (Face const face : faces) {
         // Convex polygon triangulation
-        if (cache.find(count) == cache.end()) {
-            ListOfTriangles triplets;
-            triplets.reserve(3 * (count - 2));
-            for (unsigned int i = 1; i <= count - 2; ++i) {
-                triplets.emplace_back(0, i, i + 1);
-            }
-            cache.insert({ count, triplets });
-        }
-
-        for (auto const& [x, y, z] : cache[count]) {
-            triangles.emplace_back(face[x], face[y], face[z]);
+        for (unsigned int i = 1; i + 1 < face.size(); ++i) {
+            triangles.emplace_back(face[0], face[i], face[i + 1]);
         }
     }
 
@@ -261,12 +249,16 @@ std::vector<TriangularFace> EditableMesh::GenerateTriangularFaces() const
 Mesh EditableMesh::GenerateMesh() const
 {
     Mesh mesh;
-    unsigned int size = faces.size() * 3;
-    mesh.positions.reserve(size);
-    mesh.normals.reserve(size);
 
     auto triangles = GenerateTriangularFaces();
 
+    unsigned int size = triangles.size() * 3;
+    mesh.positions.reserve(size);
+    mesh.normals.reserve(size);
+    if (HasTextureCoords()) {
+        mesh.textureCoords.reserve(size);
+    }
+
     for (auto const& f : triangles) {
         glm::vec3 p1, p2, p3;
         glm::vec3 normal;
@@ -297,17 +289,33 @@ Mesh EditableMesh::GenerateMesh() const
     return mesh;
 }
 
+Mesh EditableMesh::GenerateIndexedMesh() const
+{
+    Mesh mesh;
+
+    mesh.positions = positions;
+    mesh.faces = GenerateTriangularFaces();
+    if (HasTextureCoords()) {
+        mesh.textureCoords = textureCoords;
+    } else {
+        mesh.textureCoords = std::vector<glm::vec2>(positions.size(), glm::vec2(0.0f, 0.0f));
+    }
+
+    return mesh;
+}
+
 Wireframe EditableMesh::GenerateWireframe() const
 {
     Wireframe wf;
 
     wf.positions = positions;
+    wf.edges.reserve(faces.IndexCount());
     /**
      *  3---2
      *  |   |
      *  0---1
      */
-    for (auto const& face : faces) {
+    for (Face const face : faces) {
         unsigned int count = face.size();
         for (unsigned int i = 0; i < count; i++) {
             wf.edges.emplace_back(face[i], face[(i + 1) % count]);
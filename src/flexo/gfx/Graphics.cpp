@@ -1,8 +1,6 @@
 #include <cstdlib>
 #include <fstream>
 
-#include <stb/image.h>
-
 #include "gfx/Graphics.hpp"
 #include "log/Logger.h"
 #include "ResourcePath.hpp"
@@ -138,7 +136,12 @@ void Graphics::CreateInputLayout(GLWRInputElementDesc const* inputElementDesc, u
         }
         glEnableVertexAttribArray(location);
         auto const& [size, type, normalized] = Enum::Resolve(desc.format);
-        glVertexAttribFormat(location, size, type, normalized, desc.byteOffset);
+        // Integer attributes are only passed through unconverted with the I variant.
+        if (type == GL_UNSIGNED_INT && !normalized) {
+            glVertexAttribIFormat(location, size, type, desc.byteOffset);
+        } else {
+            glVertexAttribFormat(location, size, type, normalized, desc.byteOffset);
+        }
         glVertexAttribBinding(location, desc.inputSlot);
         glVertexBindingDivisor(desc.inputSlot, 0);
         if (desc.inputSlotClass == GLWRInputClassification_PerInstance) {
@@ -185,6 +188,12 @@ void Graphics::CreateBuffer(GLWRBufferDesc const* pDesc, GLWRResourceData const*
         glBindBuffer(GL_UNIFORM_BUFFER, self->m_id);
         glBufferData(GL_UNIFORM_BUFFER, pDesc->byteWidth, initialData->mem, pDesc->usage);
         break;
+    case GLWRResourceType_PixelUnpackBuffer:
+        // Left unbound, since a bound pixel unpack buffer turns every pointer passed to glTex(Sub)Image into an offset.
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, self->m_id);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, pDesc->byteWidth, initialData->mem, pDesc->usage);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        break;
     default:
         log_error("Graphics::CreateBuffer currently does not support this resource type.");
         break;
@@ -201,9 +210,11 @@ void Graphics::CreateTexture2D(GLWRTexture2DDesc const* pDesc, GLWRResourceData
     glActiveTexture(GL_TEXTURE0);
     if (pDesc->samples == 1) {
         glBindTexture(GL_TEXTURE_2D, self->m_id); // Bind the new texture to the context so we can modify it.
-        glTexStorage2D(GL_TEXTURE_2D, 1, pDesc->internalFormat, pDesc->width, pDesc->height);
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, pDesc->width, pDesc->height, pDesc->pixelFormat, pDesc->dataType,
-                        pInitialData->mem);
+        glTexStorage2D(GL_TEXTURE_2D, pDesc->mipLevels, pDesc->internalFormat, pDesc->width, pDesc->height);
+        if (pInitialData && pInitialData->mem) {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, pDesc->width, pDesc->height, pDesc->pixelFormat,
+                            pDesc->dataType, pInitialData->mem);
+        }
     } else if (pDesc->samples > 1) {
         glBindTexture(GL_TEXTURE_2D_MULTISAMPLE,
                       self->m_id); // Bind the new texture to the context so we can modify it.
@@ -234,7 +245,18 @@ void Graphics::CreateShaderResourceView(IGLWRResource* pResource, GLWRShaderReso
     IGLWRShaderResourceView* self = *ppResourceView;
     self->m_type = pDesc->type;
 
-    glTextureView(self->m_id, pDesc->type, pResource->m_id, pDesc->format, 0, 1, 0, 1);
+    glTextureView(self->m_id, pDesc->type, pResource->m_id, pDesc->format, 0, pDesc->mipLevels, 0, 1);
+}
+
+void Graphics::UpdateTexture2D(IGLWRTexture2D* pTexture, GLWRTexture2DDesc const* pDesc,
+                               IGLWRBuffer* pPixelUnpackBuffer)
+{
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, pTexture->m_id);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pPixelUnpackBuffer->m_id);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, pDesc->width, pDesc->height, pDesc->pixelFormat, pDesc->dataType,
+                    nullptr);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 }
 
 void Graphics::CreateSampler(GLWRSamplerDesc const* pDesc, IGLWRSampler** ppSampler)
@@ -616,6 +638,11 @@ void Graphics::Map(IGLWRResource* pResource, GLWRMapPermission permission, GLWRM
         glBindBuffer(GL_UNIFORM_BUFFER, id);
         pMappedResource->data = glMapBuffer(GL_UNIFORM_BUFFER, permission);
         break;
+    case GLWRResourceType_PixelUnpackBuffer:
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, id);
+        pMappedResource->data = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, permission);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        break;
     default:
         log_error("Graphics::Map currently does not support this resource type.");
         pMappedResource->data = nullptr;
@@ -640,6 +667,11 @@ void Graphics::Unmap(IGLWRResource* pResource)
         glBindBuffer(GL_UNIFORM_BUFFER, id);
         glUnmapBuffer(GL_UNIFORM_BUFFER);
         break;
+    case GLWRResourceType_PixelUnpackBuffer:
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, id);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        break;
     default:
         log_error("Graphics::Unmap currently does not support this resource type.");
         break;
@@ -708,39 +740,6 @@ std::string Graphics::SlurpShaderSource(std::string const& filename)
     return source;
 }
 
-void Graphics::CreateShaderResourceViewFromFile(Graphics* pContext, char const* filename,
-                                                IGLWRShaderResourceView** ppResourceView)
-{
-    int width, height, channels;
-    stbi_set_flip_vertically_on_load(0);
-    stbi_uc* image = stbi_load(filename, &width, &height, &channels, STBI_rgb_alpha);
-
-    if (image == nullptr) {
-        log_error("Failed to open image: %s. %s", filename, stbi_failure_reason());
-    }
-
-    GLWRPtr<IGLWRTexture2D> texture;
-
-    GLWRTexture2DDesc texDesc;
-    texDesc.width = width;
-    texDesc.height = height;
-    texDesc.internalFormat = GL_RGBA32F;
-    texDesc.pixelFormat = GL_RGBA;
-    texDesc.dataType = GL_UNSIGNED_BYTE;
-
-    GLWRResourceData resData;
-    resData.mem = image;
-
-    GLWRShaderResourceViewDesc viewDesc;
-    viewDesc.format = GL_RGBA32F;
-    viewDesc.type = GLWRShaderResourceViewType_Texture2D;
-
-    pContext->CreateTexture2D(&texDesc, &resData, &texture);
-    pContext->CreateShaderResourceView(texture.Get(), &viewDesc, ppResourceView);
-
-    stbi_image_free(image);
-}
-
 Graphics::GLAttribFormat Graphics::Enum::Resolve(GLWRFormat const format)
 {
     switch (format) {
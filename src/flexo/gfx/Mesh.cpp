@@ -18,7 +18,12 @@ bool Mesh::HasTextureCoords() const
     return !textureCoords.empty();
 }
 
-VertexArray GenVertexArray(Mesh const& mesh)
+bool Mesh::HasFaces() const
+{
+    return !faces.empty();
+}
+
+VertexLayout GenVertexLayout(Mesh const& mesh)
 {
     VertexLayout layout;
     if (mesh.HasPositions()) {
@@ -30,20 +35,47 @@ VertexArray GenVertexArray(Mesh const& mesh)
     if (mesh.HasTextureCoords()) {
         layout.AddAttrib("TexCoord", VertexLayout::AttribFormat::Float2);
     }
+    return layout;
+}
 
-    VertexArray arr(layout);
-    for (unsigned int i = 0; i < mesh.positions.size(); i++) {
-        if (mesh.HasPositions()) {
-            arr.Assign("Position", mesh.positions[i]);
-        }
-        if (mesh.HasNormals()) {
-            arr.Assign("Normal", mesh.normals[i]);
-        }
-        if (mesh.HasTextureCoords()) {
-            arr.Assign("TexCoord", mesh.textureCoords[i]);
-        }
-        arr.PushBack();
+void WriteVertices(Mesh const& mesh, VertexWriter const& writer)
+{
+    if (mesh.HasPositions()) {
+        writer.Fill("Position", mesh.positions);
+    }
+    if (mesh.HasNormals()) {
+        writer.Fill("Normal", mesh.normals);
+    }
+    if (mesh.HasTextureCoords()) {
+        writer.Fill("TexCoord", mesh.textureCoords);
     }
+}
 
+VertexArray GenVertexArray(Mesh const& mesh)
+{
+    VertexArray arr(GenVertexLayout(mesh), mesh.positions.size());
+    WriteVertices(mesh, arr.GetWriter());
     return arr;
 }
+
+std::vector<unsigned int> GenIndexArray(Mesh const& mesh)
+{
+    std::vector<unsigned int> indices;
+
+    if (!mesh.HasFaces()) {
+        indices.resize(mesh.positions.size());
+        for (unsigned int i = 0; i < indices.size(); i++) {
+            indices[i] = i;
+        }
+        return indices;
+    }
+
+    indices.reserve(3 * mesh.faces.size());
+    for (auto const& f : mesh.faces) {
+        indices.push_back(f.x);
+        indices.push_back(f.y);
+        indices.push_back(f.z);
+    }
+
+    return indices;
+}
@@ -1,17 +1,44 @@
+#include <utility>
+
 #include "gfx/VertexArray.hpp"
 
+VertexWriter::VertexWriter(VertexLayout const& layout, unsigned char* data, unsigned int count)
+    : m_layout(&layout)
+    , m_data(data)
+    , m_count(count)
+{
+}
+
+unsigned int VertexWriter::GetCount() const
+{
+    return m_count;
+}
+
 VertexArray::VertexArray(VertexLayout layout)
 {
     m_layout = layout;
     m_buf = std::vector<unsigned char>(m_layout.GetSize());
 }
 
+VertexArray::VertexArray(VertexLayout layout, unsigned int count)
+    : m_array(static_cast<std::size_t>(layout.GetSize()) * count)
+    , m_buf(layout.GetSize())
+    , m_layout(std::move(layout))
+    , m_count(count)
+{
+}
+
 void VertexArray::PushBack()
 {
     m_array.insert(m_array.end(), m_buf.begin(), m_buf.end());
     m_count += 1;
 }
 
+VertexWriter VertexArray::GetWriter()
+{
+    return VertexWriter(m_layout, m_array.data(), m_count);
+}
+
 VertexLayout const& VertexArray::GetLayout() const
 {
     return m_layout;
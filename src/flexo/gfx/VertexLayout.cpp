@@ -19,7 +19,7 @@ void VertexLayout::AddAttrib(std::string name, VertexLayout::AttribFormat format
     unsigned int size = AttribSize[format];
 
     m_size += size;
-    m_attrs.emplace(name, Attrib { offset });
+    m_attrs.emplace(name, Attrib { offset, size });
 
     log_debug("Added vertex attribute: (name: %s, offset: %u, size: %u)", name.c_str(), offset, size);
 }
@@ -35,6 +35,12 @@ unsigned int VertexLayout::GetOffset(std::string const& name) const
     return it->second.offset;
 }
 
+VertexLayout::Attrib const* VertexLayout::FindAttrib(std::string const& name) const
+{
+    auto const it = m_attrs.find(name);
+    return (it == m_attrs.end()) ? nullptr : &it->second;
+}
+
 unsigned int VertexLayout::GetSize() const
 {
     return m_size;
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "gfx/WeldVertices.hpp"
+
+namespace
+{
+    // Meshes with at least this many vertices are welded by sorting in parallel.
+    std::size_t const ParallelThreshold = 1 << 16;
+
+    // Sorted runs merged pairwise, must be a power of two
+    int const SortParts = 16;
+
+    using WeldKey = std::array<std::uint32_t, 8>;
+
+    struct WeldKeyHash {
+        std::size_t operator()(WeldKey const& key) const
+        {
+            std::uint64_t h = 0xcbf29ce484222325ull;
+            for (std::uint32_t word : key) {
+                h = (h ^ word) * 0x100000001b3ull;
+            }
+            return static_cast<std::size_t>(h ^ (h >> 32));
+        }
+    };
+
+    std::uint32_t Quantize(float value, float epsilon)
+    {
+        if (epsilon > 0.0f) {
+            value = std::round(value / epsilon);
+        }
+        value += 0.0f; // -0 and +0 are the same cell.
+
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    WeldKey MakeKey(Mesh const& soup, std::size_t i, float epsilon, bool normals, bool textureCoords)
+    {
+        WeldKey key {};
+        glm::vec3 const& p = soup.positions[i];
+        key[0] = Quantize(p.x, epsilon);
+        key[1] = Quantize(p.y, epsilon);
+        key[2] = Quantize(p.z, epsilon);
+        if (normals) {
+            glm::vec3 const& n = soup.normals[i];
+            key[3] = Quantize(n.x, epsilon);
+            key[4] = Quantize(n.y, epsilon);
+            key[5] = Quantize(n.z, epsilon);
+        }
+        if (textureCoords) {
+            glm::vec2 const& uv = soup.textureCoords[i];
+            key[6] = Quantize(uv.x, epsilon);
+            key[7] = Quantize(uv.y, epsilon);
+        }
+        return key;
+    }
+
+    /**
+     * Find for every vertex the first vertex with the same key by sorting
+     *
+     * Ties are sorted by index, so the first vertex of each run of equal keys is the first occurrence.
+     */
+    void FindFirstBySorting(std::vector<WeldKey> const& keys, std::vector<unsigned int>& first)
+    {
+        int const count = keys.size();
+        std::vector<unsigned int> order(count);
+        for (int i = 0; i < count; i++) {
+            order[i] = i;
+        }
+
+        auto const less = [&keys](unsigned int a, unsigned int b) {
+            return (keys[a] < keys[b]) || (keys[a] == keys[b] && a < b);
+        };
+        auto const bound = [count](int part) { return static_cast<std::size_t>(count) * part / SortParts; };
+
+#pragma omp parallel for schedule(dynamic)
+        for (int part = 0; part < SortParts; part++) {
+            std::sort(order.begin() + bound(part), order.begin() + bound(part + 1), less);
+        }
+
+        for (int width = 1; width < SortParts; width *= 2) {
+#pragma omp parallel for schedule(dynamic)
+            for (int part = 0; part < SortParts; part += 2 * width) {
+                std::inplace_merge(order.begin() + bound(part), order.begin() + bound(part + width),
+                                   order.begin() + bound(part + 2 * width), less);
+            }
+        }
+
+        for (int i = 0; i < count; i++) {
+            bool const isFirst = (i == 0) || (keys[order[i]] != keys[order[i - 1]]);
+            first[order[i]] = isFirst ? order[i] : first[order[i - 1]];
+        }
+    }
+
+    void FindFirstByHashing(std::vector<WeldKey> const& keys, std::vector<unsigned int>& first)
+    {
+        std::unordered_map<WeldKey, unsigned int, WeldKeyHash> seen;
+        seen.reserve(keys.size() / 3);
+        for (unsigned int i = 0; i < keys.size(); i++) {
+            first[i] = seen.emplace(keys[i], i).first->second;
+        }
+    }
+}
+
+Mesh WeldVertices(Mesh const& soup, float epsilon, WeldFlags flags)
+{
+    bool const normals = (flags & WeldFlags_KeepNormals) && soup.HasNormals();
+    bool const textureCoords = (flags & WeldFlags_KeepTextureCoords) && soup.HasTextureCoords();
+    int const count = soup.positions.size();
+
+    std::vector<WeldKey> keys(count);
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < count; i++) {
+        keys[i] = MakeKey(soup, i, epsilon, normals, textureCoords);
+    }
+
+    std::vector<unsigned int> first(count);
+    if (keys.size() >= ParallelThreshold) {
+        FindFirstBySorting(keys, first);
+    } else {
+        FindFirstByHashing(keys, first);
+    }
+    keys = std::vector<WeldKey>();
+
+    // A vertex is welded to its first occurrence, which always comes before it.
+    Mesh mesh;
+    std::vector<unsigned int> remap(count);
+    for (int i = 0; i < count; i++) {
+        if (first[i] == static_cast<unsigned int>(i)) {
+            remap[i] = mesh.positions.size();
+            mesh.positions.push_back(soup.positions[i]);
+            if (normals) {
+                mesh.normals.push_back(soup.normals[i]);
+            }
+            if (textureCoords) {
+                mesh.textureCoords.push_back(soup.textureCoords[i]);
+            }
+        } else {
+            remap[i] = remap[first[i]];
+        }
+    }
+
+    mesh.faces.reserve(count / 3);
+    for (int i = 0; i + 2 < count; i += 3) {
+        TriangularFace const face(remap[i], remap[i + 1], remap[i + 2]);
+        if (face.x != face.y && face.y != face.z && face.z != face.x) {
+            mesh.faces.push_back(face);
+        }
+    }
+
+    return mesh;
+}
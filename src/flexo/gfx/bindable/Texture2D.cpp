@@ -1,16 +1,50 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+#include <stb/image.h>
+
 #include "gfx/bindable/Texture2D.hpp"
+#include "log/Logger.h"
 
 namespace Bind
 {
     Texture2D::Texture2D(Graphics& gfx, std::string const& filename, GLuint unit)
         : m_unit(unit)
+        , m_byteSize(0)
+        , m_staging(nullptr)
     {
-        Graphics::CreateShaderResourceViewFromFile(&gfx, filename.c_str(), &m_resource);
         m_name = GenerateUID(filename, unit);
+
+        unsigned char const white[4] = { 255, 255, 255, 255 };
+        GLWRPtr<IGLWRTexture2D> placeholder;
+        GLWRTexture2DDesc texDesc;
+        texDesc.width = 1;
+        texDesc.height = 1;
+        texDesc.internalFormat = GL_RGBA8;
+        texDesc.pixelFormat = GL_RGBA;
+        texDesc.dataType = GL_UNSIGNED_BYTE;
+        GLWRResourceData resData;
+        resData.mem = white;
+        GLWRShaderResourceViewDesc viewDesc;
+        viewDesc.format = GL_RGBA8;
+        viewDesc.type = GLWRShaderResourceViewType_Texture2D;
+        gfx.CreateTexture2D(&texDesc, &resData, &placeholder);
+        gfx.CreateShaderResourceView(placeholder.Get(), &viewDesc, &m_resource);
+
+        m_decoding = std::async(std::launch::async, &Texture2D::Decode, filename);
     }
 
     Texture2D::~Texture2D()
     {
+        // The copy has to be done before the buffer it writes to is deleted.
+        if (m_copying.valid()) {
+            m_copying.wait();
+        }
+        if (m_staging) {
+            m_staging->Release();
+        }
     }
 
     void Texture2D::Bind(Graphics& gfx)
@@ -18,13 +52,119 @@ namespace Bind
         gfx.SetShaderResources(m_unit, 1, m_resource.GetAddressOf());
     }
 
+    void Texture2D::Update(Graphics& gfx)
+    {
+        auto const isReady = [](auto const& future) {
+            return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        };
+
+        if (isReady(m_decoding)) {
+            BeginCopy(gfx, m_decoding.get());
+        } else if (isReady(m_copying)) {
+            m_copying.get();
+            FinishUpload(gfx);
+        }
+    }
+
     std::string const& Texture2D::GetName() const
     {
         return m_name;
     }
 
+    std::size_t Texture2D::GetByteSize() const
+    {
+        return m_byteSize;
+    }
+
+    bool Texture2D::IsPending() const
+    {
+        return m_decoding.valid() || m_copying.valid();
+    }
+
     std::string Texture2D::GenerateUID(std::string const& filename, GLuint unit)
     {
         return filename + "#" + std::to_string(unit);
     }
+
+    Texture2D::Image Texture2D::Decode(std::string filename)
+    {
+        Image image;
+        int channels;
+        stbi_set_flip_vertically_on_load_thread(0);
+        image.pixels = { stbi_load(filename.c_str(), &image.width, &image.height, &channels, STBI_rgb_alpha),
+                         stbi_image_free };
+
+        if (!image.pixels) {
+            log_error("Failed to open image: %s. %s", filename.c_str(), stbi_failure_reason());
+        }
+
+        return image;
+    }
+
+    void Texture2D::BeginCopy(Graphics& gfx, Image image)
+    {
+        // The placeholder stays if the image could not be decoded.
+        if (!image.pixels) {
+            return;
+        }
+
+        m_desc.width = image.width;
+        m_desc.height = image.height;
+        m_desc.mipLevels = 1;
+        while ((std::max(image.width, image.height) >> m_desc.mipLevels) > 0) {
+            m_desc.mipLevels++;
+        }
+        m_desc.internalFormat = GL_RGBA8;
+        m_desc.pixelFormat = GL_RGBA;
+        m_desc.dataType = GL_UNSIGNED_BYTE;
+
+        std::size_t const size = 4 * static_cast<std::size_t>(image.width) * image.height;
+
+        GLWRBufferDesc bufDesc;
+        bufDesc.type = GLWRResourceType_PixelUnpackBuffer;
+        bufDesc.usage = GL_STREAM_DRAW;
+        bufDesc.byteWidth = size;
+        bufDesc.stride = 0;
+        GLWRResourceData resData;
+        resData.mem = nullptr;
+        gfx.CreateBuffer(&bufDesc, &resData, &m_staging);
+
+        GLWRMappedSubresource mem;
+        gfx.Map(m_staging, GLWRMapPermission_WriteOnly, &mem);
+        if (mem.data == nullptr) {
+            log_error("Failed to map the staging buffer of image: %s", m_name.c_str());
+            m_staging->Release();
+            m_staging = nullptr;
+            return;
+        }
+        m_copying = std::async(std::launch::async, [dst = mem.data, size, image = std::move(image)]() {
+            std::memcpy(dst, image.pixels.get(), size);
+        });
+    }
+
+    void Texture2D::FinishUpload(Graphics& gfx)
+    {
+        gfx.Unmap(m_staging);
+
+        GLWRPtr<IGLWRTexture2D> texture;
+        gfx.CreateTexture2D(&m_desc, nullptr, &texture);
+        gfx.UpdateTexture2D(texture.Get(), &m_desc, m_staging);
+
+        GLWRShaderResourceViewDesc viewDesc;
+        viewDesc.format = GL_RGBA8;
+        viewDesc.type = GLWRShaderResourceViewType_Texture2D;
+        viewDesc.mipLevels = m_desc.mipLevels;
+        gfx.CreateShaderResourceView(texture.Get(), &viewDesc, &m_resource);
+        gfx.GenerateMips(m_resource.Get());
+
+        // The driver keeps the buffer until the upload that reads it is done.
+        m_staging->Release();
+        m_staging = nullptr;
+
+        m_byteSize = 0;
+        for (int level = 0; level < m_desc.mipLevels; level++) {
+            m_byteSize += 4 * static_cast<std::size_t>(std::max(m_desc.width >> level, 1))
+                * std::max(m_desc.height >> level, 1);
+        }
+    }
 }
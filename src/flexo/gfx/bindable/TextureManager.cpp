@@ -0,0 +1,43 @@
+#include "gfx/bindable/TextureManager.hpp"
+
+namespace Bind
+{
+    void TextureManager::SetBudget(std::size_t bytes)
+    {
+        auto& texmgr = Get();
+        texmgr.m_budget = bytes;
+        texmgr.Evict();
+    }
+
+    void TextureManager::Update(Graphics& gfx)
+    {
+        for (auto const& [key, entry] : Get().m_binds) {
+            if (entry.texture->IsPending()) {
+                entry.texture->Update(gfx);
+            }
+        }
+    }
+
+    void TextureManager::Evict()
+    {
+        std::size_t total = 0;
+        for (auto const& [key, entry] : m_binds) {
+            total += entry.texture->GetByteSize();
+        }
+
+        auto it = m_lru.end();
+        while (total > m_budget && it != m_lru.begin()) {
+            --it;
+            auto const& texture = m_binds.at(*it).texture;
+
+            // Dropping a texture that is still used would free nothing, and one that is loading would have to wait.
+            if (texture.use_count() > 1 || texture->IsPending()) {
+                continue;
+            }
+
+            total -= texture->GetByteSize();
+            m_binds.erase(*it);
+            it = m_lru.erase(it);
+        }
+    }
+}
@@ -1,9 +1,12 @@
 #include "gfx/bindable/VertexBuffer.hpp"
 
+#include "log/Logger.h"
+
 namespace Bind
 {
     VertexBuffer::VertexBuffer(Graphics& gfx, VertexArray const& vertices, unsigned int startAttrib)
-        : m_startAttrib(startAttrib)
+        : m_layout(vertices.GetLayout())
+        , m_startAttrib(startAttrib)
         , m_stride(vertices.GetStride())
         , m_count(vertices.GetCount())
     {
@@ -37,6 +40,23 @@ namespace Bind
         gfx.Unmap(m_buffer.Get());
     }
 
+    void VertexBuffer::Update(Graphics& gfx, std::function<void(VertexWriter const&)> const& write)
+    {
+        GLWRMappedSubresource mem;
+        gfx.Map(m_buffer.Get(), GLWRMapPermission_WriteOnly, &mem);
+        if (mem.data == nullptr) {
+            log_error("Failed to map the vertex buffer.");
+            return;
+        }
+        write(VertexWriter(m_layout, static_cast<unsigned char*>(mem.data), m_count));
+        gfx.Unmap(m_buffer.Get());
+    }
+
+    VertexLayout const& VertexBuffer::GetLayout() const
+    {
+        return m_layout;
+    }
+
     unsigned int VertexBuffer::GetStartAttrib() const
     {
         return m_startAttrib;
@@ -3,20 +3,28 @@
 
 #include <glm/glm.hpp>
 
+#include "FaceList.hpp"
 #include "Mesh.hpp"
 #include "Vec.hpp"
 #include "Wireframe.hpp"
 
-using Face = std::vector<unsigned int>;
+using Face = FaceList::Face;
 struct EditableMesh {
     std::vector<glm::vec3> positions;
     std::vector<glm::vec2> textureCoords;
-    std::vector<Face> faces;
+    FaceList faces;
 
     bool HasPositions() const;
     bool HasTextureCoords() const;
     std::vector<TriangularFace> GenerateTriangularFaces() const;
     Mesh GenerateMesh() const;
+    /**
+     * Triangulate the faces but keep the vertices shared
+     *
+     * The result has no normals. Drawables shade it flat by deriving the normal of each triangle in the fragment
+     * shader, which looks the same as the normals of GenerateMesh at a fraction of the vertex data.
+     */
+    Mesh GenerateIndexedMesh() const;
     Wireframe GenerateWireframe() const;
 };
 
@@ -0,0 +1,169 @@
+#ifndef FACE_LIST_H
+#define FACE_LIST_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+/**
+ * Polygon faces stored as one flat index array
+ *
+ * The indices of all faces are concatenated, and the end of every face in the index array is kept in a second array,
+ * like the rows of a CSR matrix. Adding a face appends to the two arrays instead of allocating a vector per face.
+ */
+class FaceList
+{
+public:
+    /**
+     * Read-only view of the vertex indices of a single face
+     */
+    class Face
+    {
+    public:
+        Face(unsigned int const* first, unsigned int count)
+            : m_first(first)
+            , m_count(count)
+        {
+        }
+
+        unsigned int const* begin() const
+        {
+            return m_first;
+        }
+
+        unsigned int const* end() const
+        {
+            return m_first + m_count;
+        }
+
+        unsigned int size() const
+        {
+            return m_count;
+        }
+
+        unsigned int operator[](unsigned int i) const
+        {
+            return m_first[i];
+        }
+
+    private:
+        unsigned int const* m_first;
+        unsigned int m_count;
+    };
+
+    class Iterator
+    {
+    public:
+        Iterator(FaceList const* list, std::size_t index)
+            : m_list(list)
+            , m_index(index)
+        {
+        }
+
+        Face operator*() const
+        {
+            return (*m_list)[m_index];
+        }
+
+        Iterator& operator++()
+        {
+            m_index++;
+            return *this;
+        }
+
+        bool operator!=(Iterator const& other) const
+        {
+            return m_index != other.m_index;
+        }
+
+    private:
+        FaceList const* m_list;
+        std::size_t m_index;
+    };
+
+    FaceList() = default;
+
+    FaceList(std::initializer_list<std::initializer_list<unsigned int>> faces)
+    {
+        for (auto const& face : faces) {
+            PushBack(face);
+        }
+    }
+
+    void PushBack(std::initializer_list<unsigned int> face)
+    {
+        m_indices.insert(m_indices.end(), face.begin(), face.end());
+        m_ends.push_back(m_indices.size());
+    }
+
+    /**
+     * Append the faces of another list with their indices shifted by offset
+     */
+    void Append(FaceList const& other, unsigned int offset)
+    {
+        unsigned int const base = m_indices.size();
+        for (unsigned int idx : other.m_indices) {
+            m_indices.push_back(idx + offset);
+        }
+        for (unsigned int end : other.m_ends) {
+            m_ends.push_back(end + base);
+        }
+    }
+
+    void Reserve(std::size_t faceCount, std::size_t indexCount)
+    {
+        m_ends.reserve(faceCount);
+        m_indices.reserve(indexCount);
+    }
+
+    void Clear()
+    {
+        m_indices.clear();
+        m_ends.clear();
+    }
+
+    std::size_t Size() const
+    {
+        return m_ends.size();
+    }
+
+    bool Empty() const
+    {
+        return m_ends.empty();
+    }
+
+    /**
+     * Number of vertex indices of all faces together
+     */
+    std::size_t IndexCount() const
+    {
+        return m_indices.size();
+    }
+
+    Face operator[](std::size_t i) const
+    {
+        unsigned int const first = (i == 0) ? 0 : m_ends[i - 1];
+        return Face(m_indices.data() + first, m_ends[i] - first);
+    }
+
+    Iterator begin() const
+    {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() const
+    {
+        return Iterator(this, m_ends.size());
+    }
+
+    std::vector<unsigned int> const& Indices() const
+    {
+        return m_indices;
+    }
+
+private:
+    std::vector<unsigned int> m_indices;
+    std::vector<unsigned int> m_ends;
+};
+
+#endif
@@ -119,6 +119,7 @@ struct GLWRTexture2DDesc {
     GLsizei width;
     GLsizei height;
     GLsizei samples = 1;
+    GLsizei mipLevels = 1;
     GLenum internalFormat;
     GLenum pixelFormat;
     GLenum dataType;
@@ -157,6 +158,7 @@ struct GLWRMappedSubresource {
 struct GLWRShaderResourceViewDesc {
     GLenum format;
     GLWRShaderResourceViewType type;
+    GLuint mipLevels = 1;
 };
 
 struct GLWRRenderTargetViewDesc {
@@ -228,6 +230,12 @@ public:
     void CreateRenderBuffer(GLWRRenderBufferDesc const* pDesc, IGLWRRenderBuffer** ppRenderBuffer);
     void CreateTexture2D(GLWRTexture2DDesc const* pDesc, GLWRResourceData const* pInitialData,
                          IGLWRTexture2D** ppTexture2D);
+    /**
+     * Fill the first mip level of a texture from a pixel unpack buffer
+     *
+     * The copy is queued on the GPU, so unlike uploading from client memory the call returns without waiting for it.
+     */
+    void UpdateTexture2D(IGLWRTexture2D* pTexture, GLWRTexture2DDesc const* pDesc, IGLWRBuffer* pPixelUnpackBuffer);
     void CreateShaderResourceView(IGLWRResource* pResource, GLWRShaderResourceViewDesc const* pDesc,
                                   IGLWRShaderResourceView** ppResourceView);
     void CreateSampler(GLWRSamplerDesc const* pDesc, IGLWRSampler** ppSamplerState);
@@ -269,8 +277,6 @@ public:
     void Present();
 
     static std::string SlurpShaderSource(std::string const& filename);
-    static void CreateShaderResourceViewFromFile(Graphics* pContext, char const* filename,
-                                                 IGLWRShaderResourceView** ppResourceView);
 
 private:
     void AttachShaderStage(GLuint const program, GLenum stage, char const* source);
@@ -28,6 +28,18 @@ struct Mesh {
     bool HasFaces() const;
 };
 
+VertexLayout GenVertexLayout(Mesh const& mesh);
+/**
+ * Write the attributes of the mesh in the layout of GenVertexLayout, e.g. into a mapped vertex buffer
+ */
+void WriteVertices(Mesh const& mesh, VertexWriter const& writer);
 VertexArray GenVertexArray(Mesh const& mesh);
 
+/**
+ * Flatten the triangles of a mesh into an index array
+ *
+ * A mesh without faces is a list of separate triangles, so every vertex is referenced once in order.
+ */
+std::vector<unsigned int> GenIndexArray(Mesh const& mesh);
+
 #endif
@@ -1,6 +1,7 @@
 #ifndef VERTEX_ARRAY_H
 #define VERTEX_ARRAY_H
 
+#include <cstddef>
 #include <cstring>
 #include <string>
 #include <vector>
@@ -8,13 +9,45 @@
 #include "gfx/VertexLayout.hpp"
 #include "log/Logger.h"
 
+/**
+ * Writes attributes straight into interleaved vertex memory
+ *
+ * The memory can be the storage of a VertexArray or a mapped vertex buffer. Every call writes one attribute of all
+ * vertices, and large arrays are split into vertex ranges that are filled in parallel.
+ */
+class VertexWriter
+{
+public:
+    VertexWriter(VertexLayout const& layout, unsigned char* data, unsigned int count);
+    template <typename T>
+    void Fill(std::string const& name, std::vector<T> const& values) const;
+    /**
+     * Write func(i) as the attribute of vertex i
+     *
+     * The function is called concurrently and must not depend on the order of the calls.
+     */
+    template <typename T, typename Func>
+    void Generate(std::string const& name, Func const& func) const;
+    unsigned int GetCount() const;
+
+private:
+    VertexLayout const* m_layout;
+    unsigned char* m_data;
+    unsigned int m_count;
+};
+
 class VertexArray
 {
 public:
     explicit VertexArray(VertexLayout layout);
+    /**
+     * Allocate all vertices at once to be filled through GetWriter
+     */
+    VertexArray(VertexLayout layout, unsigned int count);
     template <typename T>
     void Assign(std::string const& name, T const& value);
     void PushBack();
+    VertexWriter GetWriter();
 
     VertexLayout const& GetLayout() const;
     unsigned int GetStride() const;
@@ -40,4 +73,38 @@ void VertexArray::Assign(std::string const& name, T const& value)
     std::memcpy(&m_buf[offset], &value, sizeof(T));
 }
 
+template <typename T>
+void VertexWriter::Fill(std::string const& name, std::vector<T> const& values) const
+{
+    Generate<T>(name, [&values](unsigned int i) -> T const& { return values[i]; });
+}
+
+template <typename T, typename Func>
+void VertexWriter::Generate(std::string const& name, Func const& func) const
+{
+    // Below this many vertices, waking up the threads costs more than the copy.
+    int const parallelThreshold = 1 << 16;
+
+    auto const* attrib = m_layout->FindAttrib(name);
+    if (attrib == nullptr) {
+        log_error("Vertex attribute \"%s\" does not exist.", name.c_str());
+        return;
+    }
+    if (attrib->size != sizeof(T)) {
+        log_error("Vertex attribute \"%s\" takes %u bytes, not %zu.", name.c_str(), attrib->size, sizeof(T));
+        return;
+    }
+
+    std::size_t const offset = attrib->offset;
+    std::size_t const stride = m_layout->GetSize();
+    unsigned char* const data = m_data;
+    int const count = m_count;
+
+#pragma omp parallel for schedule(static) if (count >= parallelThreshold)
+    for (int i = 0; i < count; i++) {
+        T const value = func(static_cast<unsigned int>(i));
+        std::memcpy(data + i * stride + offset, &value, sizeof(T));
+    }
+}
+
 #endif
@@ -8,7 +8,8 @@
     X(Float, 4)                                                                                                        \
     X(Float2, 8)                                                                                                       \
     X(Float3, 12)                                                                                                      \
-    X(Float4, 16)
+    X(Float4, 16)                                                                                                      \
+    X(Uint, 4)
 
 class VertexLayout
 {
@@ -18,11 +19,16 @@ public:
 #undef X
     struct Attrib {
         unsigned int offset;
+        unsigned int size;
     };
 
 public:
     void AddAttrib(std::string name, VertexLayout::AttribFormat format);
     unsigned int GetOffset(std::string const& name) const;
+    /**
+     * @return The attribute, or nullptr if the layout has no attribute of that name
+     */
+    Attrib const* FindAttrib(std::string const& name) const;
     unsigned int GetSize() const;
 
 private:
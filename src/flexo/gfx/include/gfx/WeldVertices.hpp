@@ -0,0 +1,27 @@
+#ifndef WELD_VERTICES_H
+#define WELD_VERTICES_H
+
+#include "gfx/Mesh.hpp"
+
+using WeldFlags = int;
+
+enum WeldFlags_ : int {
+    WeldFlags_None = 0,
+    WeldFlags_KeepNormals = 1 << 0,
+    WeldFlags_KeepTextureCoords = 1 << 1,
+    WeldFlags_KeepAll = WeldFlags_KeepNormals | WeldFlags_KeepTextureCoords,
+};
+
+/**
+ * Merge the equal vertices of a triangle soup into an indexed mesh
+ *
+ * Vertices are equal if their positions, and the normals and texture coordinates that are kept, fall into the same
+ * cells of size epsilon, or are bitwise equal with an epsilon of zero. Attributes that are not kept are left out of the
+ * result. The welded vertices keep the order of their first occurrence, and triangles that collapse are dropped.
+ *
+ * Small meshes are welded with a hash map. Large ones are sorted by the cells in parallel and deduplicated instead,
+ * with the same result.
+ */
+Mesh WeldVertices(Mesh const& soup, float epsilon = 0.0f, WeldFlags flags = WeldFlags_KeepAll);
+
+#endif
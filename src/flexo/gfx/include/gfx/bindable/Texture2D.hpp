@@ -1,6 +1,9 @@
 #ifndef TEXTURE_H
 #define TEXTURE_H
 
+#include <cstddef>
+#include <future>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -9,19 +12,62 @@
 
 namespace Bind
 {
+    /**
+     * Image texture that is loaded in the background
+     *
+     * The image is decoded on a worker thread, and a white placeholder is bound until it is ready. The next Update
+     * maps a pixel unpack buffer that another worker copies the pixels into, and once the copy is done Update queues
+     * the upload from the buffer and the generation of the mipmaps. Decoding and copying never block the GL thread,
+     * and the GPU does the rest asynchronously.
+     */
     class Texture2D : public Bindable
     {
     public:
         Texture2D(Graphics& gfx, std::string const& filename, GLuint unit);
         ~Texture2D() override;
         void Bind(Graphics& gfx) override;
+
+        /**
+         * Move the loading on to its next step if the current one is done
+         *
+         * Creating and uploading textures changes the texture bound to unit 0, so this is called by
+         * TextureManager::Update before the frame is drawn rather than from Bind.
+         */
+        void Update(Graphics& gfx);
         std::string const& GetName() const;
+
+        /**
+         * Bytes taken by the uploaded image and its mipmaps, 0 while the image is still loading or if it failed to
+         */
+        std::size_t GetByteSize() const;
+
+        /**
+         * Whether the image is still being decoded or copied
+         */
+        bool IsPending() const;
+
         static std::string GenerateUID(std::string const& filename, GLuint unit);
 
     protected:
+        struct Image {
+            int width = 0;
+            int height = 0;
+            std::unique_ptr<unsigned char, void (*)(void*)> pixels { nullptr, nullptr };
+        };
+
+        static Image Decode(std::string filename);
+        void BeginCopy(Graphics& gfx, Image image);
+        void FinishUpload(Graphics& gfx);
+
         GLWRPtr<IGLWRShaderResourceView> m_resource;
         GLuint m_unit;
         std::string m_name;
+        std::size_t m_byteSize;
+
+        std::future<Image> m_decoding;
+        std::future<void> m_copying;
+        IGLWRBuffer* m_staging;
+        GLWRTexture2DDesc m_desc;
     };
 }
 
@@ -1,6 +1,8 @@
 #ifndef TEXTURE_MANAGER_H
 #define TEXTURE_MANAGER_H
 
+#include <cstddef>
+#include <list>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -11,6 +13,13 @@
 
 namespace Bind
 {
+    /**
+     * Cache of the textures loaded from files, keyed by Texture2D::GenerateUID
+     *
+     * Textures are kept after nothing uses them anymore, so that switching back to an image does not load it again.
+     * When the uploaded textures take more memory than the budget, the least recently resolved ones that are unused
+     * are dropped. Textures that are still in use or still loading are never dropped.
+     */
     class TextureManager
     {
     public:
@@ -20,8 +29,24 @@ namespace Bind
             return Get().ResolveInternal(gfx, std::forward<Params>(params)...);
         }
 
+        /**
+         * @param bytes GPU memory the cached textures may take, 256 MiB by default
+         */
+        static void SetBudget(std::size_t bytes);
+
+        /**
+         * Move the textures that are still loading on, call once per frame before anything is bound
+         */
+        static void Update(Graphics& gfx);
+
     private:
+        struct Entry {
+            std::shared_ptr<Texture2D> texture;
+            std::list<std::string>::iterator lru;
+        };
+
         TextureManager()
+            : m_budget(256 << 20)
         {
         }
 
@@ -31,14 +56,20 @@ namespace Bind
             auto const key = Texture2D::GenerateUID(std::forward<Params>(params)...);
             auto it = m_binds.find(key);
             if (it != m_binds.end()) {
-                return it->second;
+                m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+                return it->second.texture;
             } else {
+                // Sizes are only known after the upload, so the budget is enforced here rather than when it grows.
+                Evict();
                 auto bindable = std::make_shared<Texture2D>(gfx, std::forward<Params>(params)...);
-                m_binds[key] = bindable;
+                m_lru.push_front(key);
+                m_binds[key] = Entry { bindable, m_lru.begin() };
                 return bindable;
             }
         }
 
+        void Evict();
+
         static TextureManager& Get()
         {
             static TextureManager texmgr;
@@ -46,7 +77,9 @@ namespace Bind
         }
 
     private:
-        std::unordered_map<std::string, std::shared_ptr<Texture2D>> m_binds;
+        std::unordered_map<std::string, Entry> m_binds;
+        std::list<std::string> m_lru; // Most recently resolved first
+        std::size_t m_budget;
     };
 }
 
@@ -2,6 +2,7 @@
 #define VERTEXBUFFER_H
 
 #include <cstring>
+#include <functional>
 #include <vector>
 
 #include "gfx/Graphics.hpp"
@@ -14,6 +15,7 @@ namespace Bind
     {
     protected:
         GLWRPtr<IGLWRBuffer> m_buffer;
+        VertexLayout m_layout;
         unsigned int m_startAttrib;
         unsigned int m_stride;
         unsigned int m_count;
@@ -23,6 +25,11 @@ namespace Bind
         ~VertexBuffer();
         void Bind(Graphics& gfx) override;
         void Update(Graphics& gfx, VertexArray const& vertices);
+        /**
+         * Map the buffer and let the function write the vertices in place, which saves building a VertexArray first
+         */
+        void Update(Graphics& gfx, std::function<void(VertexWriter const&)> const& write);
+        VertexLayout const& GetLayout() const;
         unsigned int GetStartAttrib() const;
         unsigned int GetCount() const;
     };
@@ -7,6 +7,7 @@ typedef enum {
     GLWRResourceType_Buffer,
     GLWRResourceType_IndexBuffer,
     GLWRResourceType_UniformBuffer,
+    GLWRResourceType_PixelUnpackBuffer,
     GLWRResourceType_Texture1D,
     GLWRResourceType_Texture2D,
     GLWRResourceType_Texture3D,
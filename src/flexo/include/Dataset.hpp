@@ -1,32 +1,44 @@
 #ifndef INCLUDE_DATA_H
 #define INCLUDE_DATA_H
 
+#include <cstddef>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <vector>
 
 #include "gfx/Mesh.hpp"
-#include "RandomIntNumber.hpp"
 #include "Vec.hpp"
+#include "Xoshiro256.hpp"
 
 template <int InDim>
 class Dataset
 {
 public:
-    Dataset();
-    Dataset(std::vector<glm::vec3> const& positions);
-    Dataset(std::vector<Vec<InDim>> const& positions);
+    Dataset(std::uint64_t seed = 0);
+    Dataset(std::vector<glm::vec3> const& positions, std::uint64_t seed = 0);
+    Dataset(std::vector<Vec<InDim>> const& positions, std::uint64_t seed = 0);
     void Insert(std::vector<glm::vec3> const& positions);
     void Insert(std::vector<Vec<InDim>> const& positions);
     std::vector<Vec<InDim>> const& GetData() const;
+
+    /**
+     * Draw a random sample
+     *
+     * The sample indices are generated in blocks ahead of time, so a training step only reads the next index.
+     * The sequence only depends on the seed and the number of samples.
+     */
     Vec<InDim> const& GetInput();
     BoundingBox const& GetBoundingBox() const;
 
 private:
     std::vector<Vec<InDim>> m_pos;
-    RandomIntNumber<unsigned int> m_rng;
+    Xoshiro256 m_engine;
+    std::vector<unsigned int> m_indices;
+    std::size_t m_next;
     BoundingBox m_box;
 
     void CalculateBoundingBox();
+    void GenerateIndices();
 };
 
 #include "Dataset.inl"
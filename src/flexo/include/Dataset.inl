@@ -1,16 +1,20 @@
 #include "Dataset.hpp"
 
 template <int InDim>
-Dataset<InDim>::Dataset()
+Dataset<InDim>::Dataset(std::uint64_t seed)
     : m_pos()
-    , m_rng()
+    , m_engine(seed)
+    , m_indices()
+    , m_next(0)
 {
 }
 
 template <int InDim>
-Dataset<InDim>::Dataset(std::vector<glm::vec3> const& positions)
+Dataset<InDim>::Dataset(std::vector<glm::vec3> const& positions, std::uint64_t seed)
     : m_pos()
-    , m_rng()
+    , m_engine(seed)
+    , m_indices()
+    , m_next(0)
 {
     std::vector<Vec<InDim>> data;
     data.reserve(positions.size());
@@ -20,16 +24,16 @@ Dataset<InDim>::Dataset(std::vector<glm::vec3> const& positions)
 
     m_pos = data;
 
-    m_rng.setRange(0, m_pos.size() - 1);
     CalculateBoundingBox();
 }
 
 template <int InDim>
-Dataset<InDim>::Dataset(std::vector<Vec<InDim>> const& positions)
+Dataset<InDim>::Dataset(std::vector<Vec<InDim>> const& positions, std::uint64_t seed)
     : m_pos(positions)
-    , m_rng()
+    , m_engine(seed)
+    , m_indices()
+    , m_next(0)
 {
-    m_rng.setRange(0, m_pos.size() - 1);
     CalculateBoundingBox();
 }
 
@@ -43,7 +47,7 @@ void Dataset<InDim>::Insert(std::vector<glm::vec3> const& positions)
     }
 
     m_pos.insert(m_pos.end(), data.begin(), data.end());
-    m_rng.setRange(0, m_pos.size() - 1);
+    m_next = m_indices.size(); // The pending indices were drawn for the old size.
     CalculateBoundingBox();
 }
 
@@ -51,7 +55,7 @@ template <int InDim>
 void Dataset<InDim>::Insert(std::vector<Vec<InDim>> const& positions)
 {
     m_pos.insert(m_pos.end(), positions.begin(), positions.end());
-    m_rng.setRange(0, m_pos.size() - 1);
+    m_next = m_indices.size(); // The pending indices were drawn for the old size.
     CalculateBoundingBox();
 }
 
@@ -64,7 +68,23 @@ std::vector<Vec<InDim>> const& Dataset<InDim>::GetData() const
 template <int InDim>
 Vec<InDim> const& Dataset<InDim>::GetInput()
 {
-    return m_pos[m_rng.scalar()];
+    if (m_next == m_indices.size()) {
+        GenerateIndices();
+    }
+    return m_pos[m_indices[m_next++]];
+}
+
+template <int InDim>
+void Dataset<InDim>::GenerateIndices()
+{
+    std::size_t const blockSize = 4096;
+    std::uint32_t const count = static_cast<std::uint32_t>(m_pos.size());
+
+    m_indices.resize(blockSize);
+    for (auto& index : m_indices) {
+        index = m_engine.Below(count);
+    }
+    m_next = 0;
 }
 
 template <int InDim>
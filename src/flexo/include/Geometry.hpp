@@ -9,7 +9,7 @@ namespace geom
     {
     public:
         Edge(glm::vec3 tail, glm::vec3 head);
-        glm::vec3 ClosestPointTo(glm::vec3 point);
+        glm::vec3 ClosestPointTo(glm::vec3 point) const;
 
     private:
         glm::vec3 tail;
@@ -21,8 +21,8 @@ namespace geom
     public:
         Triangle(glm::vec3 A, glm::vec3 B, glm::vec3 C);
 
-        glm::vec3 ClosestPointTo(glm::vec3 point);
-        glm::vec3 BarycentricCoordinates(glm::vec3 point);
+        glm::vec3 ClosestPointTo(glm::vec3 point) const;
+        glm::vec3 BarycentricCoordinates(glm::vec3 point) const;
 
     private:
         using Vertex = glm::vec3;
@@ -2,13 +2,14 @@
 #include <utility>
 
 #include "gfx/EditableMesh.hpp"
+#include "log/Logger.h"
 #include "VecUtil.hpp"
 #include "object/Map.hpp"
 #include "ResourcePath.hpp"
 
 template <int InDim, int OutDim>
 template <typename... Params>
-Node<InDim, OutDim>& Map<InDim, OutDim>::At(Params&&... coordinates)
+typename NodeStore<InDim, OutDim>::Reference Map<InDim, OutDim>::At(Params&&... coordinates)
 {
     static_assert(sizeof...(Params) == OutDim);
 
@@ -24,15 +25,10 @@ Node<InDim, OutDim>& Map<InDim, OutDim>::At(Params&&... coordinates)
     return nodes[index];
 }
 
-template <int InDim, int OutDim>
-EditableMesh const& Map<InDim, OutDim>::GetMesh() const
-{
-    return m_mesh;
-}
-
 template <int InDim, int OutDim>
 Map<InDim, OutDim>::Map()
     : Object(ObjectType_Map)
+    , m_isBeingTrained(false)
 {
 }
 
@@ -44,11 +40,17 @@ void Map<InDim, OutDim>::GenerateMesh()
     int const width = size.x;
     int const height = size.y;
 
+    // A map that has never been published is still owned by the GUI thread and can be read directly.
+    m_snapshots.Consume();
+    auto const& weights = m_snapshots.Front();
+    bool const isPublished = (weights.size() == nodes.size());
+
     for (auto const& node : nodes) {
-        mesh.positions.push_back(VECCONV(node.weights));
-        mesh.textureCoords.push_back(VECCONV(node.uv));
+        mesh.positions.push_back(VECCONV(isPublished ? weights[node.Index()] : node.Weights()));
+        mesh.textureCoords.push_back(VECCONV(node.UV()));
     }
 
+    mesh.faces.Reserve((height - 1) * (width - 1), 4 * (height - 1) * (width - 1));
     for (int y = 0; y < height - 1; ++y) {
         for (int x = 0; x < width - 1; ++x) {
             unsigned int const idx = y * width + x;
@@ -65,11 +67,11 @@ void Map<InDim, OutDim>::GenerateMesh()
             i3 = idx + width + 1;
             i4 = idx + width;
 
-            mesh.faces.push_back({ i1, i2, i3, i4 });
+            mesh.faces.PushBack({ i1, i2, i3, i4 });
         }
     }
 
-    m_mesh = mesh;
+    m_mesh = std::move(mesh);
 }
 
 template <int InDim, int OutDim>
@@ -80,18 +82,77 @@ void Map<InDim, OutDim>::GenerateDrawables(Graphics& gfx)
     if (!m_texture) {
         m_texture = Bind::TextureManager::Resolve(gfx, ResourcePath::GetImageFile("blank.png"), 0);
     }
-    auto m = m_mesh.GenerateMesh();
+    auto m = m_mesh.GenerateIndexedMesh();
     m_solid = std::make_shared<SolidDrawable>(gfx, m);
-    m_textured = std::make_shared<TexturedDrawable>(gfx, m_mesh.GenerateMesh(), m_texture);
+    m_textured = std::make_shared<TexturedDrawable>(gfx, m, m_texture);
     m_wire = std::make_shared<WireDrawable>(gfx, m_mesh.GenerateWireframe());
 }
 
+template <int InDim, int OutDim>
+void Map<InDim, OutDim>::UpdateDrawables(Graphics& gfx)
+{
+    if (!m_solid || !m_textured || !m_wire) {
+        GenerateDrawables(gfx);
+        return;
+    }
+
+    if (!m_snapshots.Consume()) {
+        return;
+    }
+
+    auto const& weights = m_snapshots.Front();
+    if (weights.size() != m_mesh.positions.size()) {
+        GenerateDrawables(gfx);
+        return;
+    }
+
+    // The faces only depend on the map size, so only the positions have to be refreshed.
+    for (std::size_t i = 0; i < weights.size(); i++) {
+        m_mesh.positions[i] = VECCONV(weights[i]);
+    }
+
+    auto m = m_mesh.GenerateIndexedMesh();
+    if (!m_solid->UpdateVertices(gfx, m) || !m_textured->UpdateVertices(gfx, m)
+        || !m_wire->UpdatePositions(gfx, m_mesh.positions)) {
+        GenerateDrawables(gfx);
+    }
+}
+
 template <int InDim, int OutDim>
 void Map<InDim, OutDim>::ApplyTransform()
 {
+    if (m_isBeingTrained) {
+        log_warn("The map is being trained, apply the transform after the training is over");
+        return;
+    }
+
     auto mat = GenerateTransformStack().GenerateMatrix();
-    for (auto& n : nodes) {
-        n.weights = VECCONV(glm::vec3(mat * glm::vec4(VECCONV(n.weights), 1.0f)));
+    for (auto const& n : nodes) {
+        n.SetWeights(VECCONV(glm::vec3(mat * glm::vec4(VECCONV(n.Weights()), 1.0f))));
     }
     m_transform = Transform();
+    PublishWeights();
+}
+
+template <int InDim, int OutDim>
+void Map<InDim, OutDim>::SetBeingTrained(bool trained)
+{
+    m_isBeingTrained = trained;
+}
+
+template <int InDim, int OutDim>
+bool Map<InDim, OutDim>::IsBeingTrained() const
+{
+    return m_isBeingTrained;
+}
+
+template <int InDim, int OutDim>
+void Map<InDim, OutDim>::PublishWeights()
+{
+    auto& weights = m_snapshots.Back();
+    weights.resize(nodes.size());
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        weights[i] = nodes.GetWeights(i);
+    }
+    m_snapshots.Publish();
 }
@@ -0,0 +1,62 @@
+#ifndef MESH_VOXELIZER_H
+#define MESH_VOXELIZER_H
+
+#include <functional>
+#include <memory>
+
+#include <glm/glm.hpp>
+
+#include "VoxelSliceSource.hpp"
+#include "gfx/Mesh.hpp"
+
+/**
+ * Volume of unsigned char voxels kept in memory, in the layout of VolumetricModelData
+ */
+class VoxelGrid : public VoxelSliceSource
+{
+public:
+    /**
+     * The voxels are not cleared, so that whoever fills them can clear the slices in parallel as they go
+     */
+    VoxelGrid(glm::ivec3 resolution, glm::vec3 voxelDims, glm::vec3 origin);
+
+    unsigned char* GetBuffer();
+    unsigned char const* GetBuffer() const;
+    unsigned char const* GetSlice(int z, unsigned char* scratch) const override;
+    glm::ivec3 GetResolution() const override;
+    glm::vec3 GetVoxelDims() const override;
+    glm::vec3 GetGridOrigin() const;
+
+private:
+    glm::ivec3 m_resolution;
+    glm::vec3 m_vxDims;
+    glm::vec3 m_origin;
+    std::unique_ptr<unsigned char[]> m_voxels;
+};
+
+/**
+ * Called after every slab with the percentage of slices done, returns false to stop the voxelization
+ *
+ * The slabs are voxelized in parallel, so it is called from the worker threads, though never from two at once.
+ */
+using VoxelizeProgress = std::function<bool(float)>;
+
+/**
+ * Turn the triangles of a mesh into model voxels
+ *
+ * Every voxel that a triangle touches is set, decided by a separating axis test between the triangle and the voxel.
+ * The triangles are binned by the slabs of slices they cross, and the slabs are voxelized in parallel.
+ *
+ * With solid, the inside of the mesh is filled as well: rays through the voxel centres along X are intersected with
+ * the triangles, and the voxels between every pair of crossings are set. The mesh has to be closed for that.
+ *
+ * @param mesh       Triangles, either indexed by the faces or taken three vertices at a time
+ * @param resolution Number of voxels along the longest side of the bounding box
+ * @param solid      Fill the inside of the mesh
+ * @param progress   Optional progress report, which can stop the voxelization
+ * @return The voxels, or nullptr if the voxelization was stopped
+ */
+std::unique_ptr<VoxelGrid> VoxelizeMesh(Mesh const& mesh, int resolution, bool solid,
+                                        VoxelizeProgress const& progress = nullptr);
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef MODEL_IMPORT_H
+#define MODEL_IMPORT_H
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+
+#include "object/SurfaceVoxels.hpp"
+
+/**
+ * Import of a model file on a worker thread
+ *
+ * The file is read, decompressed or voxelized, its surface voxels are extracted and their mesh is generated, all
+ * without a GL context. Only the drawables of the result still have to be generated on the GL thread. Volumes are
+ * decompressed slice by slice as the extraction goes, so cancelling stops the decompression as well.
+ *
+ * Any error is kept for GetError instead of ending the program.
+ */
+class ModelImport
+{
+public:
+    /**
+     * Start the import
+     *
+     * @param filename   RVL volume, or STL or OBJ mesh that is voxelized first
+     * @param resolution Number of voxels along the longest side of a mesh
+     * @param solid      Fill the inside of a mesh
+     */
+    ModelImport(std::string filename, int resolution = 128, bool solid = true);
+
+    /**
+     * Cancel the import and wait for the worker to stop
+     */
+    ~ModelImport();
+    ModelImport(ModelImport const&) = delete;
+    ModelImport& operator=(ModelImport const&) = delete;
+
+    /**
+     * Ask the worker to stop at the next slab of slices or layer of faces, the result is then nullptr without an
+     * error
+     */
+    void Cancel();
+
+    /**
+     * @return Whether the import finished within the timeout
+     */
+    bool WaitFor(std::chrono::milliseconds timeout) const;
+
+    /**
+     * Percentage of the import done so far
+     */
+    float GetProgress() const;
+
+    /**
+     * Wait for the import to finish
+     *
+     * @return The model, or nullptr if the import failed or was cancelled
+     */
+    std::shared_ptr<SurfaceVoxels> GetResult();
+
+    /**
+     * Why the import failed, or an empty string. Only valid after the import finished.
+     */
+    std::string const& GetError() const;
+
+private:
+    void Run();
+
+    std::string m_filename;
+    int m_resolution;
+    bool m_solid;
+
+    std::atomic<bool> m_cancel;
+    std::atomic<float> m_progress;
+    std::shared_ptr<SurfaceVoxels> m_result;
+    std::string m_error;
+    std::future<void> m_task;
+};
+
+#endif
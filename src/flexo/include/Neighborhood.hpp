@@ -1,6 +1,9 @@
 #ifndef NEIGHBORHOOD_H
 #define NEIGHBORHOOD_H
 
+#include <vector>
+
+#include "LearningRate.hpp"
 #include "Vec.hpp"
 
 struct NeighborhoodRadius {
@@ -19,6 +22,26 @@ struct Neighborhood {
     NeighborhoodRadius radius;
 };
 
+/**
+ * Learning rate and neighborhood of one training step, tabulated over integer grid offsets
+ *
+ * The gaussian is separable, h(dx, dy) = g(dx) * g(dy), so a single row of g is enough to look up any offset. The
+ * update of a node then costs two multiplications instead of the exponentials of LearningRate and Neighborhood.
+ */
+struct NeighborhoodKernel {
+    NeighborhoodKernel();
+
+    /**
+     * Tabulate the kernel of step t, reusing the storage of the previous step
+     */
+    void Evaluate(Neighborhood const& neighborhood, LearningRate const& learnRate, int t);
+
+    int radius;               // Nodes with dx * dx + dy * dy < radius * radius are inside the neighborhood
+    float rate;               // Learning rate of the step
+    std::vector<float> taps;  // g(k) for k in [-radius, radius], stored at k + radius
+    std::vector<int> spans;   // Largest |dx| inside the neighborhood for |dy| in [0, radius)
+};
+
 template <int OutDim>
 float Neighborhood::operator()(int t, Vec<OutDim> coordBMU, Vec<OutDim> coordNode) const
 {
@@ -0,0 +1,71 @@
+#ifndef NODE_GRID_H
+#define NODE_GRID_H
+
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "Vec.hpp"
+#include "gfx/Mesh.hpp"
+
+/**
+ * Uniform grid over the node weights of a map
+ *
+ * The grid spans the bounding box of the dataset and every cell keeps a copy of the weights of the nodes that fall
+ * into it. Nodes outside of the box are clamped into the border cells. The grid is kept in sync with the map by
+ * calling Update() whenever the weights of a node change.
+ */
+template <int InDim>
+class NodeGrid
+{
+    struct Entry {
+        unsigned int index;
+        Vec<InDim> weights;
+    };
+
+    struct Slot {
+        unsigned int cell;
+        unsigned int offset;
+    };
+
+public:
+    /**
+     * @param box       Bounding box of the input space
+     * @param nodeCount Number of nodes the grid will hold
+     */
+    NodeGrid(BoundingBox const& box, unsigned int nodeCount);
+
+    /**
+     * Insert a node or move it to the cell where its new weights belong.
+     *
+     * @param index   Index of the node in the map
+     * @param weights Current weights of the node
+     */
+    void Update(unsigned int index, Vec<InDim> const& weights);
+
+    /**
+     * Find the node nearest to the input vector
+     *
+     * Cells are visited in rings of growing Chebyshev distance around the cell of the input vector until no
+     * unvisited cell can contain a closer node.
+     *
+     * @param input Input vector
+     * @return Index of the nearest node
+     */
+    unsigned int FindNearest(Vec<InDim> const& input) const;
+
+private:
+    glm::ivec3 CellCoords(Vec<InDim> const& weights) const;
+    unsigned int CellIndex(glm::ivec3 const& coords) const;
+    void SearchCell(unsigned int cell, Vec<InDim> const& input, float& distMin, unsigned int& nearest) const;
+
+    glm::vec3 m_min;
+    glm::vec3 m_max;
+    glm::vec3 m_cellSize;
+    glm::ivec3 m_dims;
+    float m_minCellSize;
+    std::vector<std::vector<Entry>> m_cells;
+    std::vector<Slot> m_slots;
+};
+
+#include "NodeGrid.inl"
+#endif
@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "NodeGrid.hpp"
+
+template <int InDim>
+NodeGrid<InDim>::NodeGrid(BoundingBox const& box, unsigned int nodeCount)
+    : m_min(box.min)
+    , m_max(box.max)
+    , m_cellSize(1.0f)
+    , m_dims(1)
+    , m_minCellSize(std::numeric_limits<float>::max())
+    , m_cells()
+    , m_slots(nodeCount, Slot { std::numeric_limits<unsigned int>::max(), 0 })
+{
+    static_assert(InDim >= 3, "The grid is built over the first three weight components.");
+
+    // Aim for about two nodes per cell. Degenerated axes of a flat dataset get a single layer of cells.
+    int const maxDimension = 256;
+    float const targetCells = std::max(1.0f, 0.5f * static_cast<float>(nodeCount));
+    glm::vec3 const extent = m_max - m_min;
+    float const maxExtent = std::max({ extent.x, extent.y, extent.z });
+    float const minExtent = maxExtent * 1e-3f;
+
+    int axes = 0;
+    float volume = 1.0f;
+    for (int i = 0; i < 3; i++) {
+        if (extent[i] > minExtent) {
+            volume *= extent[i];
+            axes++;
+        }
+    }
+
+    if (axes > 0) {
+        float const cellSize = std::pow(volume / targetCells, 1.0f / static_cast<float>(axes));
+        for (int i = 0; i < 3; i++) {
+            if (extent[i] > minExtent) {
+                m_dims[i] = std::clamp(static_cast<int>(std::ceil(extent[i] / cellSize)), 1, maxDimension);
+                m_cellSize[i] = extent[i] / static_cast<float>(m_dims[i]);
+            }
+            if (m_dims[i] > 1) {
+                m_minCellSize = std::min(m_minCellSize, m_cellSize[i]);
+            }
+        }
+    }
+
+    m_cells.resize(m_dims.x * m_dims.y * m_dims.z);
+}
+
+template <int InDim>
+void NodeGrid<InDim>::Update(unsigned int index, Vec<InDim> const& weights)
+{
+    unsigned int const cell = CellIndex(CellCoords(weights));
+    Slot& slot = m_slots[index];
+
+    if (slot.cell == cell) {
+        m_cells[cell][slot.offset].weights = weights;
+        return;
+    }
+
+    if (slot.cell != std::numeric_limits<unsigned int>::max()) {
+        auto& entries = m_cells[slot.cell];
+        entries[slot.offset] = entries.back();
+        m_slots[entries[slot.offset].index].offset = slot.offset;
+        entries.pop_back();
+    }
+
+    slot.cell = cell;
+    slot.offset = static_cast<unsigned int>(m_cells[cell].size());
+    m_cells[cell].push_back({ index, weights });
+}
+
+template <int InDim>
+unsigned int NodeGrid<InDim>::FindNearest(Vec<InDim> const& input) const
+{
+    glm::ivec3 const center = CellCoords(input);
+
+    // The ring bound only holds inside the box, so inputs outside of it pay for their distance to the box.
+    float outside = 0.0f;
+    for (int i = 0; i < 3; i++) {
+        float const d = input[i] - std::clamp(input[i], m_min[i], m_max[i]);
+        outside += d * d;
+    }
+    outside = std::sqrt(outside);
+
+    int maxRing = 0;
+    for (int i = 0; i < 3; i++) {
+        maxRing = std::max({ maxRing, center[i], m_dims[i] - 1 - center[i] });
+    }
+
+    float distMin = std::numeric_limits<float>::max();
+    unsigned int nearest = 0;
+
+    for (int r = 0; r <= maxRing; r++) {
+        if (r > 0) {
+            // Every unvisited cell is at least r - 1 whole cells away from the input.
+            float const bound = static_cast<float>(r - 1) * m_minCellSize - outside;
+            if (bound > 0.0f && bound * bound > distMin) {
+                break;
+            }
+        }
+
+        int const z0 = std::max(0, center.z - r);
+        int const z1 = std::min(m_dims.z - 1, center.z + r);
+        int const y0 = std::max(0, center.y - r);
+        int const y1 = std::min(m_dims.y - 1, center.y + r);
+        int const x0 = std::max(0, center.x - r);
+        int const x1 = std::min(m_dims.x - 1, center.x + r);
+
+        for (int z = z0; z <= z1; z++) {
+            for (int y = y0; y <= y1; y++) {
+                if (std::abs(z - center.z) == r || std::abs(y - center.y) == r) {
+                    for (int x = x0; x <= x1; x++) {
+                        SearchCell(CellIndex({ x, y, z }), input, distMin, nearest);
+                    }
+                } else {
+                    if (center.x - r >= 0) {
+                        SearchCell(CellIndex({ center.x - r, y, z }), input, distMin, nearest);
+                    }
+                    if (center.x + r < m_dims.x) {
+                        SearchCell(CellIndex({ center.x + r, y, z }), input, distMin, nearest);
+                    }
+                }
+            }
+        }
+    }
+
+    return nearest;
+}
+
+template <int InDim>
+glm::ivec3 NodeGrid<InDim>::CellCoords(Vec<InDim> const& weights) const
+{
+    glm::ivec3 coords;
+    for (int i = 0; i < 3; i++) {
+        float const c = std::floor((weights[i] - m_min[i]) / m_cellSize[i]);
+        coords[i] = static_cast<int>(std::clamp(c, 0.0f, static_cast<float>(m_dims[i] - 1)));
+    }
+    return coords;
+}
+
+template <int InDim>
+unsigned int NodeGrid<InDim>::CellIndex(glm::ivec3 const& coords) const
+{
+    return coords.x + m_dims.x * (coords.y + m_dims.y * coords.z);
+}
+
+template <int InDim>
+void NodeGrid<InDim>::SearchCell(unsigned int cell, Vec<InDim> const& input, float& distMin,
+                                 unsigned int& nearest) const
+{
+    for (auto const& entry : m_cells[cell]) {
+        Vec<InDim> const diff = input - entry.weights;
+        float const dist = diff * diff;
+        if (dist < distMin || (dist == distMin && entry.index < nearest)) {
+            distMin = dist;
+            nearest = entry.index;
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef NODE_KERNELS_H
+#define NODE_KERNELS_H
+
+/**
+ * Training kernels operating on structure-of-arrays node weights
+ *
+ * The weights are given as one array per dimension. The implementation (AVX2, SSE2 or scalar) is picked once at
+ * runtime depending on what the CPU supports.
+ */
+namespace kernel
+{
+    /**
+     * Name of the instruction set used by the kernels
+     */
+    char const* InstructionSet();
+
+    /**
+     * Find the node with the smallest squared distance to the input vector
+     *
+     * Ties are resolved to the lower index.
+     *
+     * @param weights Weight arrays, one per dimension
+     * @param dims    Number of weight dimensions
+     * @param count   Number of nodes
+     * @param input   Input vector with dims components
+     * @return Index of the nearest node
+     */
+    unsigned int FindNearest(float const* const* weights, int dims, unsigned int count, float const* input);
+
+    /**
+     * Move a run of nodes towards the input vector
+     *
+     * For every node i the weights become w + rates[i] * (input - w).
+     *
+     * @param weights Weight arrays, one per dimension, pointing at the first node of the run
+     * @param dims    Number of weight dimensions
+     * @param count   Number of nodes in the run
+     * @param rates   Per-node factors, i.e. learning rate times neighborhood
+     * @param input   Input vector with dims components
+     */
+    void Attract(float* const* weights, int dims, unsigned int count, float const* rates, float const* input);
+}
+
+#endif
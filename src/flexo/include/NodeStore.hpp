@@ -0,0 +1,100 @@
+#ifndef NODE_STORE_H
+#define NODE_STORE_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "AlignedAllocator.hpp"
+#include "Node.hpp"
+#include "Vec.hpp"
+
+/**
+ * Structure-of-arrays storage of map nodes
+ *
+ * Every weight dimension lives in its own aligned float array so that the training kernels can stream them with
+ * SIMD loads. Coordinates and texture coordinates are only read occasionally and stay interleaved.
+ * Single nodes are accessed through lightweight accessor views.
+ */
+template <int InDim, int OutDim>
+class NodeStore
+{
+public:
+    using WeightArray = std::vector<float, AlignedAllocator<float, 32>>;
+
+    /**
+     * View of a single node inside the store
+     *
+     * The view holds no data itself and is only valid as long as the store is not resized.
+     */
+    template <typename Store>
+    class Accessor
+    {
+    public:
+        Accessor(Store& store, std::size_t index);
+        Vec<InDim> Weights() const;
+        void SetWeights(Vec<InDim> const& weights) const;
+        Vec<OutDim> const& Coords() const;
+        Vec<OutDim> const& UV() const;
+        float X() const;
+        float Y() const;
+        std::size_t Index() const;
+
+    private:
+        Store* m_store;
+        std::size_t m_index;
+    };
+
+    template <typename Store>
+    class Iterator
+    {
+    public:
+        Iterator(Store& store, std::size_t index);
+        Accessor<Store> operator*() const;
+        Iterator& operator++();
+        bool operator!=(Iterator const& other) const;
+
+    private:
+        Store* m_store;
+        std::size_t m_index;
+    };
+
+    using Reference = Accessor<NodeStore>;
+    using ConstReference = Accessor<NodeStore const>;
+
+    NodeStore();
+
+    template <typename... Args>
+    void emplace_back(Args&&... args);
+    void push_back(Node<InDim, OutDim> const& node);
+    void reserve(std::size_t count);
+    void clear();
+    std::size_t size() const;
+    bool empty() const;
+
+    Reference operator[](std::size_t index);
+    ConstReference operator[](std::size_t index) const;
+    Iterator<NodeStore> begin();
+    Iterator<NodeStore> end();
+    Iterator<NodeStore const> begin() const;
+    Iterator<NodeStore const> end() const;
+
+    Vec<InDim> GetWeights(std::size_t index) const;
+    void SetWeights(std::size_t index, Vec<InDim> const& weights);
+    Vec<OutDim> const& GetCoords(std::size_t index) const;
+    Vec<OutDim> const& GetUV(std::size_t index) const;
+
+    /**
+     * Base pointers of the weight arrays, one per weight dimension
+     */
+    std::array<float*, InDim> WeightPointers();
+    std::array<float const*, InDim> WeightPointers() const;
+
+private:
+    std::array<WeightArray, InDim> m_weights;
+    std::vector<Vec<OutDim>> m_coords;
+    std::vector<Vec<OutDim>> m_uv;
+};
+
+#include "NodeStore.inl"
+#endif
@@ -0,0 +1,235 @@
+#include <utility>
+
+#include "NodeStore.hpp"
+
+template <int InDim, int OutDim>
+template <typename Store>
+NodeStore<InDim, OutDim>::Accessor<Store>::Accessor(Store& store, std::size_t index)
+    : m_store(&store)
+    , m_index(index)
+{
+}
+
+template <int InDim, int OutDim>
+template <typename Store>
+Vec<InDim> NodeStore<InDim, OutDim>::Accessor<Store>::Weights() const
+{
+    return m_store->GetWeights(m_index);
+}
+
+template <int InDim, int OutDim>
+template <typename Store>
+void NodeStore<InDim, OutDim>::Accessor<Store>::SetWeights(Vec<InDim> const& weights) const
+{
+    m_store->SetWeights(m_index, weights);
+}
+
+template <int InDim, int OutDim>
+template <typename Store>
+Vec<OutDim> const& NodeStore<InDim, OutDim>::Accessor<Store>::Coords() const
+{
+    return m_store->GetCoords(m_index);
+}
+
+template <int InDim, int OutDim>
+template <typename Store>
+Vec<OutDim> const& NodeStore<InDim, OutDim>::Accessor<Store>::UV() const
+{
+    return m_store->GetUV(m_index);
+}
+
+template <int InDim, int OutDim>
+template <typename Store>
+float NodeStore<InDim, OutDim>::Accessor<Store>::X() const
+{
+    return m_store->GetCoords(m_index)[0];
+}
+
+template <int InDim, int OutDim>
+template <typename Store>
+float NodeStore<InDim, OutDim>::Accessor<Store>::Y() const
+{
+    return m_store->GetCoords(m_index)[1];
+}
+
+template <int InDim, int OutDim>
+template <typename Store>
+std::size_t NodeStore<InDim, OutDim>::Accessor<Store>::Index() const
+{
+    return m_index;
+}
+
+template <int InDim, int OutDim>
+template <typename Store>
+NodeStore<InDim, OutDim>::Iterator<Store>::Iterator(Store& store, std::size_t index)
+    : m_store(&store)
+    , m_index(index)
+{
+}
+
+template <int InDim, int OutDim>
+template <typename Store>
+typename NodeStore<InDim, OutDim>::template Accessor<Store> NodeStore<InDim, OutDim>::Iterator<Store>::operator*() const
+{
+    return Accessor<Store>(*m_store, m_index);
+}
+
+template <int InDim, int OutDim>
+template <typename Store>
+typename NodeStore<InDim, OutDim>::template Iterator<Store>& NodeStore<InDim, OutDim>::Iterator<Store>::operator++()
+{
+    ++m_index;
+    return *this;
+}
+
+template <int InDim, int OutDim>
+template <typename Store>
+bool NodeStore<InDim, OutDim>::Iterator<Store>::operator!=(Iterator const& other) const
+{
+    return m_index != other.m_index;
+}
+
+template <int InDim, int OutDim>
+NodeStore<InDim, OutDim>::NodeStore()
+    : m_weights()
+    , m_coords()
+    , m_uv()
+{
+}
+
+template <int InDim, int OutDim>
+template <typename... Args>
+void NodeStore<InDim, OutDim>::emplace_back(Args&&... args)
+{
+    push_back(Node<InDim, OutDim>(std::forward<Args>(args)...));
+}
+
+template <int InDim, int OutDim>
+void NodeStore<InDim, OutDim>::push_back(Node<InDim, OutDim> const& node)
+{
+    for (int d = 0; d < InDim; d++) {
+        m_weights[d].push_back(node.weights[d]);
+    }
+    m_coords.push_back(node.coords);
+    m_uv.push_back(node.uv);
+}
+
+template <int InDim, int OutDim>
+void NodeStore<InDim, OutDim>::reserve(std::size_t count)
+{
+    for (auto& w : m_weights) {
+        w.reserve(count);
+    }
+    m_coords.reserve(count);
+    m_uv.reserve(count);
+}
+
+template <int InDim, int OutDim>
+void NodeStore<InDim, OutDim>::clear()
+{
+    for (auto& w : m_weights) {
+        w.clear();
+    }
+    m_coords.clear();
+    m_uv.clear();
+}
+
+template <int InDim, int OutDim>
+std::size_t NodeStore<InDim, OutDim>::size() const
+{
+    return m_coords.size();
+}
+
+template <int InDim, int OutDim>
+bool NodeStore<InDim, OutDim>::empty() const
+{
+    return m_coords.empty();
+}
+
+template <int InDim, int OutDim>
+typename NodeStore<InDim, OutDim>::Reference NodeStore<InDim, OutDim>::operator[](std::size_t index)
+{
+    return Reference(*this, index);
+}
+
+template <int InDim, int OutDim>
+typename NodeStore<InDim, OutDim>::ConstReference NodeStore<InDim, OutDim>::operator[](std::size_t index) const
+{
+    return ConstReference(*this, index);
+}
+
+template <int InDim, int OutDim>
+typename NodeStore<InDim, OutDim>::template Iterator<NodeStore<InDim, OutDim>> NodeStore<InDim, OutDim>::begin()
+{
+    return Iterator<NodeStore>(*this, 0);
+}
+
+template <int InDim, int OutDim>
+typename NodeStore<InDim, OutDim>::template Iterator<NodeStore<InDim, OutDim>> NodeStore<InDim, OutDim>::end()
+{
+    return Iterator<NodeStore>(*this, size());
+}
+
+template <int InDim, int OutDim>
+typename NodeStore<InDim, OutDim>::template Iterator<NodeStore<InDim, OutDim> const>
+NodeStore<InDim, OutDim>::begin() const
+{
+    return Iterator<NodeStore const>(*this, 0);
+}
+
+template <int InDim, int OutDim>
+typename NodeStore<InDim, OutDim>::template Iterator<NodeStore<InDim, OutDim> const>
+NodeStore<InDim, OutDim>::end() const
+{
+    return Iterator<NodeStore const>(*this, size());
+}
+
+template <int InDim, int OutDim>
+Vec<InDim> NodeStore<InDim, OutDim>::GetWeights(std::size_t index) const
+{
+    Vec<InDim> weights;
+    for (int d = 0; d < InDim; d++) {
+        weights[d] = m_weights[d][index];
+    }
+    return weights;
+}
+
+template <int InDim, int OutDim>
+void NodeStore<InDim, OutDim>::SetWeights(std::size_t index, Vec<InDim> const& weights)
+{
+    for (int d = 0; d < InDim; d++) {
+        m_weights[d][index] = weights[d];
+    }
+}
+
+template <int InDim, int OutDim>
+Vec<OutDim> const& NodeStore<InDim, OutDim>::GetCoords(std::size_t index) const
+{
+    return m_coords[index];
+}
+
+template <int InDim, int OutDim>
+Vec<OutDim> const& NodeStore<InDim, OutDim>::GetUV(std::size_t index) const
+{
+    return m_uv[index];
+}
+
+template <int InDim, int OutDim>
+std::array<float*, InDim> NodeStore<InDim, OutDim>::WeightPointers()
+{
+    std::array<float*, InDim> pointers;
+    for (int d = 0; d < InDim; d++) {
+        pointers[d] = m_weights[d].data();
+    }
+    return pointers;
+}
+
+template <int InDim, int OutDim>
+std::array<float const*, InDim> NodeStore<InDim, OutDim>::WeightPointers() const
+{
+    std::array<float const*, InDim> pointers;
+    for (int d = 0; d < InDim; d++) {
+        pointers[d] = m_weights[d].data();
+    }
+    return pointers;
+}
@@ -17,6 +17,7 @@ class RandomIntNumber : public RandomNumber<T>
 public:
     RandomIntNumber();
     RandomIntNumber(T min, T max);
+    RandomIntNumber(T min, T max, std::uint64_t seed);
     void setRange(T min, T max);
     virtual T scalar() override;
     virtual std::vector<T> vector(std::size_t dimension) override;
@@ -51,6 +52,14 @@ RandomIntNumber<T>::RandomIntNumber(T min, T max)
     static_assert(isInt8 | isInt16 | isInt32 | isInt64 | isUInt8 | isUInt16 | isUInt32 | isUInt64);
 }
 
+template <typename T>
+RandomIntNumber<T>::RandomIntNumber(T min, T max, std::uint64_t seed)
+    : RandomNumber<T>(seed)
+    , m_range { min, max }
+{
+    static_assert(std::is_integral_v<T>);
+}
+
 template <typename T>
 void RandomIntNumber<T>::setRange(T min, T max)
 {
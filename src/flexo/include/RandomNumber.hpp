@@ -3,18 +3,28 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <random>
 #include <vector>
 
+#include "Xoshiro256.hpp"
+
 template <typename T>
 class RandomNumber
 {
 protected:
-    std::random_device m_device;
-    std::mt19937_64 m_engine;
+    Xoshiro256 m_engine;
 
 public:
+    /**
+     * Seed from the random device
+     */
     RandomNumber();
+
+    /**
+     * Seed explicitly, so that the same seed always yields the same numbers
+     */
+    explicit RandomNumber(std::uint64_t seed);
     virtual ~RandomNumber();
     virtual T scalar() = 0;
     virtual std::vector<T> vector(std::size_t dimension) = 0;
@@ -24,8 +34,13 @@ public:
 
 template <typename T>
 RandomNumber<T>::RandomNumber()
-    : m_device {}
-    , m_engine(m_device())
+    : m_engine(std::random_device {}())
+{
+}
+
+template <typename T>
+RandomNumber<T>::RandomNumber(std::uint64_t seed)
+    : m_engine(seed)
 {
 }
 
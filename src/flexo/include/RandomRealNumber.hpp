@@ -2,6 +2,7 @@
 #define RANDOM_REAL_NUMBER_H
 
 #include <array>
+#include <cstdint>
 #include <random>
 #include <type_traits>
 #include <vector>
@@ -15,6 +16,7 @@ class RandomRealNumber : public RandomNumber<T>
 
 public:
     RandomRealNumber(T min, T max);
+    RandomRealNumber(T min, T max, std::uint64_t seed);
     virtual T scalar() override;
     virtual std::vector<T> vector(std::size_t dimension) override;
     template <std::size_t S>
@@ -34,6 +36,14 @@ RandomRealNumber<T>::RandomRealNumber(T min, T max)
     static_assert(isFloat | isDouble | isLongDouble);
 }
 
+template <typename T>
+RandomRealNumber<T>::RandomRealNumber(T min, T max, std::uint64_t seed)
+    : RandomNumber<T>(seed)
+    , m_range { min, max }
+{
+    static_assert(std::is_floating_point_v<T>);
+}
+
 template <typename T>
 T RandomRealNumber<T>::scalar()
 {
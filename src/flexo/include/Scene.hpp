@@ -1,6 +1,7 @@
 #ifndef DRAW_LIST_H
 #define DRAW_LIST_H
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -9,12 +10,12 @@
 #include <wx/event.h>
 
 #include "Attachable.hpp"
-#include "VolumetricModelData.hpp"
 #include "object/Map.hpp"
 #include "object/Object.hpp"
 
 class FlexoProject;
 class Renderer;
+class SurfaceVoxels;
 
 class Scene : public AttachableBase
 {
@@ -28,8 +29,8 @@ public:
     void AddUVSphere(int numSegments = 32, int numRings = 16, float radius = 1.0f);
     void AddTorus(int majorSeg = 48, int minorSeg = 12, float majorRad = 1.0f, float minorRad = 0.25f);
     void AddGrid(int numXDiv = 10, int numYDiv = 10, float size = 2.0f);
-    void AddMap(int width, int height, MapFlags flags, MapInitState initState);
-    void AddModel(VolumetricModelData const& data);
+    void AddMap(int width, int height, MapFlags flags, MapInitState initState, std::uint64_t seed);
+    void AddModel(std::shared_ptr<SurfaceVoxels> model);
     std::weak_ptr<Object> GetObject(std::string const& id) const;
     std::vector<std::string> GetAllModelsByID() const;
     std::vector<std::string> GetAllMapsByID() const;
@@ -1,34 +1,41 @@
 #ifndef SELF_ORGANIZING_MAP_H
 #define SELF_ORGANIZING_MAP_H
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include <glm/glm.hpp>
-#include <wx/event.h>
 
-#include "Attachable.hpp"
 #include "Dataset.hpp"
 #include "LearningRate.hpp"
 #include "Neighborhood.hpp"
-#include "Node.hpp"
+#include "NodeGrid.hpp"
+#include "NodeKernels.hpp"
 #include "SelfOrganizingMapModel.hpp"
 #include "Vec.hpp"
 #include "log/Logger.h"
 #include "object/Map.hpp"
 
-class FlexoProject;
-
 class SelfOrganizingMap
 {
-    bool m_isDone;
-    bool m_isTraining;
+    std::atomic<bool> m_isDone;
+    std::atomic<bool> m_isTraining;
     int m_tmax;
-    int m_t;
+    std::atomic<int> m_t;
+    int m_publishInterval;
     LearningRate m_learnRate;
     Neighborhood m_neighborhood;
+    BMUSearch m_bmuSearch;
+    TrainingMode m_trainingMode;
+    NeighborhoodKernel m_kernel;
+    std::vector<float> m_rates;
 
     std::thread m_worker;
     std::mutex m_mut;
@@ -36,7 +43,7 @@ class SelfOrganizingMap
 
 public:
     template <int InDim, int OutDim>
-    SelfOrganizingMap(SelfOrganizingMapModel<InDim, OutDim>& model, FlexoProject& project);
+    SelfOrganizingMap(SelfOrganizingMapModel<InDim, OutDim>& model);
     ~SelfOrganizingMap();
     SelfOrganizingMap(SelfOrganizingMap const&) = delete;
     SelfOrganizingMap& operator=(SelfOrganizingMap const&) = delete;
@@ -60,49 +67,69 @@ private:
     template <int InDim, int OutDim>
     void Train(std::shared_ptr<Map<InDim, OutDim>> map, std::shared_ptr<Dataset<InDim>> dataset);
 
+    /**
+     * One epoch of batch SOM training
+     *
+     * The BMUs of all samples are found in parallel. The samples are then summed up per BMU and smoothed over the map
+     * with the neighborhood kernel, and every node is replaced by the weighted mean of the samples it received.
+     * The result does not depend on the number of threads.
+     *
+     * @param map     Map we are training
+     * @param dataset Dataset as the input space of SOM
+     * @param grid    Spatial index to search and to keep in sync, or nullptr
+     */
+    template <int InDim, int OutDim>
+    void TrainEpoch(Map<InDim, OutDim>& map, Dataset<InDim> const& dataset, NodeGrid<InDim>* grid);
+
     /**
      * Find the Best Matching Unit
      *
      * Walk through the nodes and calculate the distance between the input vector and their weight vectors.
      * The node having the smallest distance to the input vector is the BMU.
+     * When a grid is given, only the cells around the input vector are searched.
      *
      * @param map Map we are training
      * @param input   Input vector
+     * @param grid    Spatial index over the node weights, or nullptr for the exhaustive search
+     * @return Index of the BMU in the map
      */
     template <int InDim, int OutDim>
-    Node<InDim, OutDim> const& FindBMU(Map<InDim, OutDim> const& map, Vec<InDim> const& input) const;
+    unsigned int FindBMU(Map<InDim, OutDim> const& map, Vec<InDim> const& input, NodeGrid<InDim> const* grid) const;
 
     /**
      * Update the neighborhood of the BMU
      *
      * Walk through the nodes and find the nodes within BMU's neighborhood.
-     * The node having the smallest distance to the input vector is the BMU.
+     * The factors of each row are the row tap times the column taps of the tabulated kernel, and the row is then
+     * moved towards the input vector by one kernel call.
      *
-     * @param map Map we are training.
-     * @param input   Input vector
-     * @param bmu     The Best Matching Unit
-     * @param radius  Neighborhood radius
+     * @param map          Map we are training.
+     * @param input        Input vector
+     * @param bmu          Index of the Best Matching Unit
+     * @param neighborhood Neighborhood tabulated for the current step
+     * @param grid         Spatial index to keep in sync with the moved nodes, or nullptr
      */
     template <int InDim, int OutDim>
-    void UpdateNodes(Map<InDim, OutDim>& map, Vec<InDim> input, Node<InDim, OutDim> const& bmu, LearningRate learnRate,
-                     Neighborhood neighborhood);
-
-    FlexoProject& m_project;
+    void UpdateNodes(Map<InDim, OutDim>& map, Vec<InDim> input, unsigned int bmu,
+                     NeighborhoodKernel const& neighborhood, NodeGrid<InDim>* grid);
 };
 
 template <int InDim, int OutDim>
-SelfOrganizingMap::SelfOrganizingMap(SelfOrganizingMapModel<InDim, OutDim>& model, FlexoProject& project)
+SelfOrganizingMap::SelfOrganizingMap(SelfOrganizingMapModel<InDim, OutDim>& model)
     : m_isDone(false)
     , m_isTraining(false)
     , m_worker()
     , m_mut()
     , m_cv()
-    , m_project(project)
 {
     m_t = 0;
     m_tmax = model.maxSteps;
+    // Every epoch of batch training is worth a preview, while online steps are cheap.
+    m_publishInterval = (model.trainingMode == TrainingMode_Batch) ? 1 : 1000;
     m_learnRate = LearningRate(model.learningRate, m_tmax);
     m_neighborhood = Neighborhood(NeighborhoodRadius(model.neighborhood, m_tmax));
+    m_bmuSearch = model.bmuSearch;
+    m_trainingMode = model.trainingMode;
 
     auto object = model.object.lock();
     auto map = model.map.lock();
@@ -113,8 +140,12 @@ SelfOrganizingMap::SelfOrganizingMap(SelfOrganizingMapModel<InDim, OutDim>& mode
     }
 
     auto const& pos = object->GetPositions();
-    auto dataset = std::make_shared<Dataset<3>>(pos);
-    log_info("Dataset count: %lu", pos.size());
+    auto dataset = std::make_shared<Dataset<3>>(pos, model.seed);
+    log_info("Dataset count: %lu, seed: %llu", pos.size(), static_cast<unsigned long long>(model.seed));
+    log_info("SOM kernels: %s", kernel::InstructionSet());
+
+    // Taken before the worker starts, so that nothing else can publish in between.
+    map->SetBeingTrained(true);
 
     void (SelfOrganizingMap::*Train)(std::shared_ptr<Map<InDim, OutDim>>, std::shared_ptr<Dataset<InDim>>)
         = &SelfOrganizingMap::Train;
@@ -126,93 +157,275 @@ SelfOrganizingMap::SelfOrganizingMap(SelfOrganizingMapModel<InDim, OutDim>& mode
 template <int InDim, int OutDim>
 void SelfOrganizingMap::Train(std::shared_ptr<Map<InDim, OutDim>> map, std::shared_ptr<Dataset<InDim>> dataset)
 {
+    std::unique_ptr<NodeGrid<InDim>> grid;
+    if (m_bmuSearch == BMUSearch_UniformGrid) {
+        grid = std::make_unique<NodeGrid<InDim>>(dataset->GetBoundingBox(), map->nodes.size());
+        for (unsigned int i = 0; i < map->nodes.size(); i++) {
+            grid->Update(i, map->nodes.GetWeights(i));
+        }
+        log_info("BMU search: uniform grid");
+    }
+
+    if (m_trainingMode == TrainingMode_Batch) {
+        log_info("Batch training: %d epochs", m_tmax);
+    }
+
     while (m_t < m_tmax) {
-        std::unique_lock lk(m_mut);
-        m_cv.wait(lk, [this] { return m_isTraining || m_isDone; });
+        if (!m_isTraining) {
+            map->PublishWeights();
+            std::unique_lock lk(m_mut);
+            m_cv.wait(lk, [this] { return m_isTraining || m_isDone; });
+        }
         if (m_isDone) {
             break;
         }
 
-        Vec<InDim> const input = dataset->GetInput();
-        auto const& bmu = FindBMU(*map, input);
-        UpdateNodes(*map, input, bmu, m_learnRate, m_neighborhood);
+        if (m_trainingMode == TrainingMode_Batch) {
+            TrainEpoch(*map, *dataset, grid.get());
+        } else {
+            Vec<InDim> const input = dataset->GetInput();
+            unsigned int const bmu = FindBMU(*map, input, grid.get());
+            m_kernel.Evaluate(m_neighborhood, m_learnRate, m_t);
+            UpdateNodes(*map, input, bmu, m_kernel, grid.get());
+        }
 
         ++m_t;
+
+        if (m_t % m_publishInterval == 0) {
+            map->PublishWeights();
+        }
     }
 
+    map->PublishWeights();
+    map->SetBeingTrained(false);
     m_isDone = true;
 }
 
 template <int InDim, int OutDim>
-Node<InDim, OutDim> const& SelfOrganizingMap::FindBMU(Map<InDim, OutDim> const& map, Vec<InDim> const& input) const
+void SelfOrganizingMap::TrainEpoch(Map<InDim, OutDim>& map, Dataset<InDim> const& dataset, NodeGrid<InDim>* grid)
 {
-    glm::ivec2 idx(0, 0);
-    float distMin = std::numeric_limits<float>::max();
-    for (int i = 0; i < map.size.x; i++) {
-        for (int j = 0; j < map.size.y; j++) {
-            Vec<InDim> const diff = input - map.nodes[i + j * map.size.x].weights;
-            float const diffLen = diff * diff;
-            if (distMin > diffLen) {
-                distMin = diffLen;
-                idx = { i, j };
+    auto& nodes = map.nodes;
+    auto const& data = dataset.GetData();
+    int const sampleCount = static_cast<int>(data.size());
+    int const width = map.size.x;
+    int const height = map.size.y;
+    int const nodeCount = width * height;
+    bool const cyclicX = map.flags & MapFlags_CyclicX;
+    bool const cyclicY = map.flags & MapFlags_CyclicY;
+
+    // The seam column and row of a cyclic map mirror the first ones, so only the others are trained.
+    int const cols = cyclicX ? width - 1 : width;
+    int const rows = cyclicY ? height - 1 : height;
+
+    std::vector<unsigned int> bmus(sampleCount);
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < sampleCount; i++) {
+        bmus[i] = FindBMU(map, data[i], grid);
+    }
+
+    // Per-node channels: the sums of each weight dimension followed by the number of hits.
+    int const channels = InDim + 1;
+    std::vector<double> hits(channels * nodeCount, 0.0);
+    for (int i = 0; i < sampleCount; i++) {
+        int x = bmus[i] % width;
+        int y = bmus[i] / width;
+        x = (x < cols) ? x : 0;
+        y = (y < rows) ? y : 0;
+        int const index = x + y * width;
+        for (int d = 0; d < InDim; d++) {
+            hits[d * nodeCount + index] += data[i][d];
+        }
+        hits[InDim * nodeCount + index] += 1.0;
+    }
+
+    // The gaussian neighborhood is separable, so smooth the rows first and then the columns.
+    m_kernel.Evaluate(m_neighborhood, m_learnRate, m_t);
+    int const half = std::max(m_kernel.radius - 1, 0);
+    float const* taps = m_kernel.taps.data() + m_kernel.radius;
+
+    std::vector<double> rowSums(channels * nodeCount, 0.0);
+#pragma omp parallel for schedule(static)
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            int const index = x + y * width;
+            for (int k = -half; k <= half; k++) {
+                int sx = x + k;
+                if (cyclicX) {
+                    sx = ((sx % cols) + cols) % cols;
+                } else if (sx < 0 || sx >= cols) {
+                    continue;
+                }
+                double const h = taps[k];
+                for (int c = 0; c < channels; c++) {
+                    rowSums[c * nodeCount + index] += h * hits[c * nodeCount + sx + y * width];
+                }
+            }
+        }
+    }
+
+    std::vector<double> sums(channels * nodeCount, 0.0);
+#pragma omp parallel for schedule(static)
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            int const index = x + y * width;
+            for (int k = -half; k <= half; k++) {
+                int sy = y + k;
+                if (cyclicY) {
+                    sy = ((sy % rows) + rows) % rows;
+                } else if (sy < 0 || sy >= rows) {
+                    continue;
+                }
+                double const h = taps[k];
+                for (int c = 0; c < channels; c++) {
+                    sums[c * nodeCount + index] += h * rowSums[c * nodeCount + x + sy * width];
+                }
+            }
+
+            double const weight = sums[InDim * nodeCount + index];
+            if (weight > 0.0) {
+                Vec<InDim> weights;
+                for (int d = 0; d < InDim; d++) {
+                    weights[d] = static_cast<float>(sums[d * nodeCount + index] / weight);
+                }
+                nodes.SetWeights(index, weights);
             }
         }
     }
 
-    return map.nodes[idx.x + idx.y * map.size.x];
+    if (cyclicX) {
+        for (int y = 0; y < height; y++) {
+            nodes.SetWeights(y * width + width - 1, nodes.GetWeights(y * width + 0));
+        }
+    }
+
+    if (cyclicY) {
+        for (int x = 0; x < width; x++) {
+            nodes.SetWeights((height - 1) * width + x, nodes.GetWeights(0 * width + x));
+        }
+    }
+
+    if (grid) {
+        for (int i = 0; i < nodeCount; i++) {
+            grid->Update(i, nodes.GetWeights(i));
+        }
+    }
+}
+
+template <int InDim, int OutDim>
+unsigned int SelfOrganizingMap::FindBMU(Map<InDim, OutDim> const& map, Vec<InDim> const& input,
+                                        NodeGrid<InDim> const* grid) const
+{
+    if (grid) {
+        return grid->FindNearest(input);
+    }
+
+    std::array<float, InDim> in;
+    for (int d = 0; d < InDim; d++) {
+        in[d] = input[d];
+    }
+
+    auto const weights = map.nodes.WeightPointers();
+    return kernel::FindNearest(weights.data(), InDim, static_cast<unsigned int>(map.nodes.size()), in.data());
 }
 
 template <int InDim, int OutDim>
-void SelfOrganizingMap::UpdateNodes(Map<InDim, OutDim>& map, Vec<InDim> input, Node<InDim, OutDim> const& bmu,
-                                    LearningRate learnRate, Neighborhood neighborhood)
+void SelfOrganizingMap::UpdateNodes(Map<InDim, OutDim>& map, Vec<InDim> input, unsigned int bmu,
+                                    NeighborhoodKernel const& neighborhood, NodeGrid<InDim>* grid)
 {
     auto& nodes = map.nodes;
     MapFlags const flags = map.flags;
     int const width = map.size.x;
     int const height = map.size.y;
+    int const rad = neighborhood.radius;
 
-    int const rad = static_cast<int>(neighborhood.radius(m_t));
-    int const radSqr = rad * rad;
+    Vec<OutDim> const bmuCoord = nodes.GetCoords(bmu);
+    int const bmuX = static_cast<int>(bmuCoord[0]);
+    int const bmuY = static_cast<int>(bmuCoord[1]);
+
+    std::array<float, InDim> in;
+    for (int d = 0; d < InDim; d++) {
+        in[d] = input[d];
+    }
+
+    auto const weights = nodes.WeightPointers();
+    std::array<float*, InDim> run;
 
     int w = width - 1;
     int h = height - 1;
-    for (int x = bmu.X() - rad; x <= bmu.X() + rad; x++) {
-        int modX = x;
-        if (flags & MapFlags_CyclicX) {
-            modX = ((x % w) + w) % w;
+    for (int y = bmuY - rad; y <= bmuY + rad; y++) {
+        int modY = y;
+        if (flags & MapFlags_CyclicY) {
+            modY = ((y % h) + h) % h;
         } else {
-            if (x < 0 || x >= width)
+            if (y < 0 || y >= height)
                 continue;
         }
-        for (int y = bmu.Y() - rad; y <= bmu.Y() + rad; y++) {
-            int modY = y;
-            if (flags & MapFlags_CyclicY) {
-                modY = ((y % h) + h) % h;
+
+        // The nodes inside the neighborhood form one contiguous span of the row.
+        int const dy = std::abs(bmuY - y);
+        if (dy >= rad) {
+            continue;
+        }
+        int const span = neighborhood.spans[dy];
+        int const xBegin = bmuX - span;
+        int const xEnd = bmuX + span;
+
+        int const length = xEnd - xBegin + 1;
+        float const rowRate = neighborhood.rate * neighborhood.taps[rad + dy];
+        float const* taps = neighborhood.taps.data() + (rad - span);
+        m_rates.resize(length);
+        for (int i = 0; i < length; i++) {
+            m_rates[i] = rowRate * taps[i];
+        }
+
+        // Split the span where it leaves the map or wraps around the seam.
+        int x = xBegin;
+        while (x <= xEnd) {
+            int modX = x;
+            int count = xEnd - x + 1;
+            if (flags & MapFlags_CyclicX) {
+                modX = ((x % w) + w) % w;
+                count = std::min(count, w - modX);
             } else {
-                if (y < 0 || y >= height)
+                if (x < 0) {
+                    x = 0;
                     continue;
+                }
+                if (x >= width)
+                    break;
+                count = std::min(count, width - x);
             }
-            float const dx = bmu.X() - x;
-            float const dy = bmu.Y() - y;
-            float const distToBmuSqr = dx * dx + dy * dy;
-            if (distToBmuSqr < radSqr) {
-                auto& node = nodes[modX + modY * width];
-                Vec<OutDim> const bmuCoord = bmu.coords;
-                Vec<OutDim> const nodeCoord(static_cast<float>(x), static_cast<float>(y));
-                node.weights += learnRate(m_t) * neighborhood(m_t, bmuCoord, nodeCoord) * (input - node.weights);
+
+            unsigned int const first = modX + modY * width;
+            for (int d = 0; d < InDim; d++) {
+                run[d] = weights[d] + first;
             }
+            kernel::Attract(run.data(), InDim, count, m_rates.data() + (x - xBegin), in.data());
+
+            if (grid) {
+                for (unsigned int i = first; i < first + count; i++) {
+                    grid->Update(i, nodes.GetWeights(i));
+                }
+            }
+            x += count;
         }
     }
 
     if (map.flags & MapFlags_CyclicX) {
         for (int y = 0; y < height; y++) {
-            nodes[y * width + width - 1].weights = nodes[y * width + 0].weights;
+            nodes.SetWeights(y * width + width - 1, nodes.GetWeights(y * width + 0));
+            if (grid) {
+                grid->Update(y * width + width - 1, nodes.GetWeights(y * width + width - 1));
+            }
         }
     }
 
     if (map.flags & MapFlags_CyclicY) {
         for (int x = 0; x < width; x++) {
-            nodes[(height - 1) * width + x].weights = nodes[0 * width + x].weights;
+            nodes.SetWeights((height - 1) * width + x, nodes.GetWeights(0 * width + x));
+            if (grid) {
+                grid->Update((height - 1) * width + x, nodes.GetWeights((height - 1) * width + x));
+            }
         }
     }
 }
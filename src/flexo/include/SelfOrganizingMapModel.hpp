@@ -1,9 +1,21 @@
 #ifndef SELF_ORGANIZING_MAP_MODEL
 #define SELF_ORGANIZING_MAP_MODEL
 
+#include <cstdint>
+
 #include <object/Map.hpp>
 #include <object/Object.hpp>
 
+enum BMUSearch {
+    BMUSearch_BruteForce = 0,
+    BMUSearch_UniformGrid,
+};
+
+enum TrainingMode {
+    TrainingMode_Online = 0,
+    TrainingMode_Batch,
+};
+
 template <int InDim, int OutDim>
 struct SelfOrganizingMapModel {
     std::weak_ptr<Map<InDim, OutDim>> map;
@@ -11,6 +23,9 @@ struct SelfOrganizingMapModel {
     float learningRate;
     unsigned int maxSteps;
     float neighborhood;
+    BMUSearch bmuSearch;
+    TrainingMode trainingMode;
+    std::uint64_t seed; // Seed of the input sampling, equal seeds give equal training runs
 };
 
 #endif
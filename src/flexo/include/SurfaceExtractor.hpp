@@ -0,0 +1,30 @@
+#ifndef SURFACE_EXTRACTOR_H
+#define SURFACE_EXTRACTOR_H
+
+#include <functional>
+
+#include "Voxel.hpp"
+#include "VoxelSliceSource.hpp"
+
+/**
+ * Called after every slab with the percentage of slices done, returns false to stop the extraction
+ */
+using ExtractProgress = std::function<bool(float)>;
+
+/**
+ * Find the model voxels that have at least one face towards air
+ *
+ * The volume is read slice by slice and packed into bit planes, so the 6-neighbour test is a few shifts and ANDs for
+ * 64 voxels at once. Slabs of slices are classified in parallel, and only the packed slabs are kept. The voxels are
+ * emitted in the order of the volume as soon as their slab is done, so the memory needed besides the slab is up to
+ * the receiver.
+ *
+ * @param source   Volume to scan
+ * @param emit     Called with every surface voxel
+ * @param progress Optional, may stop the extraction between slabs
+ * @return Whether the whole volume was scanned
+ */
+bool ExtractSurfaceVoxels(VoxelSliceSource const& source, std::function<void(Voxel const&)> const& emit,
+                          ExtractProgress const& progress = nullptr);
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef TRIANGLE_BVH_H
+#define TRIANGLE_BVH_H
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Geometry.hpp"
+#include "gfx/Mesh.hpp"
+
+/**
+ * Bounding volume hierarchy over the triangles of a mesh for closest-point queries
+ *
+ * The tree is built once from a snapshot of the positions and is read-only afterwards, so it can be queried from any
+ * number of threads at the same time.
+ */
+class TriangleBVH
+{
+public:
+    /**
+     * @param positions Vertex positions
+     * @param faces     Triangles indexing into positions
+     */
+    TriangleBVH(std::vector<glm::vec3> const& positions, std::vector<TriangularFace> const& faces);
+
+    /**
+     * Find the triangle closest to a point
+     *
+     * The result is the same as testing every triangle in order: ties are resolved to the lower face index, and
+     * degenerate triangles that yield no valid closest point are skipped.
+     *
+     * @param point   Query point
+     * @param closest Closest point on the found triangle
+     * @return Index of the closest face, or the number of faces if there is none
+     */
+    unsigned int FindClosest(glm::vec3 const& point, glm::vec3& closest) const;
+
+private:
+    struct Box {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    struct Node {
+        Box box;
+        unsigned int first; // First face of a leaf, or the second child of an inner node
+        unsigned int count; // Number of faces of a leaf, zero for inner nodes
+    };
+
+    unsigned int Build(unsigned int first, unsigned int count);
+
+    // Per-face data, stored in the order of the leaves
+    std::vector<unsigned int> m_order;
+    std::vector<Box> m_boxes;
+    std::vector<geom::Triangle> m_triangles;
+
+    std::vector<glm::vec3> m_centroids;
+    std::vector<Node> m_nodes;
+};
+
+#endif
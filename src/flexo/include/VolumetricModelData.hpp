@@ -1,28 +1,57 @@
 #ifndef VOLUMETRIC_MODEL_DATA_H
 #define VOLUMETRIC_MODEL_DATA_H
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 #include <glm/glm.hpp>
 #include <rvl.h>
 
-class VolumetricModelData
+#include "VoxelSliceSource.hpp"
+
+class VolumetricModelData : public VoxelSliceSource
 {
 
 public:
     VolumetricModelData();
     ~VolumetricModelData();
-    void Read(std::string const filename);
+
+    /**
+     * @return Whether the file could be read, otherwise GetError tells why
+     */
+    bool Read(std::string const filename);
+
+    /**
+     * Read only the information of a file
+     *
+     * Uncompressed voxels are mapped, and the others are left in the file and decompressed slice by slice in
+     * GetSlice. GetBuffer returns nullptr unless the voxels are mapped.
+     *
+     * @return Whether the file could be opened, otherwise GetError tells why
+     */
+    bool Open(std::string const filename);
+
+    /**
+     * Why reading failed, or an empty string
+     *
+     * A slice that cannot be decompressed is returned as air, so this has to be checked after the slices are read.
+     */
+    std::string const& GetError() const;
+
     unsigned char const* GetBuffer() const;
-    glm::ivec3 GetResolution() const;
-    glm::vec3 GetVoxelDims() const;
+    unsigned char const* GetSlice(int z, unsigned char* scratch) const override;
+    glm::ivec3 GetResolution() const override;
+    glm::vec3 GetVoxelDims() const override;
     glm::vec3 GetGridOrigin() const;
 
 private:
     glm::ivec3 m_resolution;
     glm::vec3 m_vxDims;
     glm::vec3 m_origin;
-    unsigned char* m_data;
+    unsigned char const* m_data; // Points into the file mapping or m_storage
+    std::vector<unsigned char> m_storage;
+    mutable std::string m_error;
     RVL* m_rvl;
 };
 
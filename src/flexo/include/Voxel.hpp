@@ -30,8 +30,9 @@ enum VoxelVis_ : unsigned char {
 };
 
 struct Voxel {
-    Voxel(glm::vec3 pos, glm::vec2 uv, VoxelVis vis = VoxelVis_All);
+    Voxel(glm::ivec3 coord, glm::vec3 pos, glm::vec2 uv, VoxelVis vis = VoxelVis_All);
 
+    glm::ivec3 coord; // Index in the volume, which is kept through transforms
     glm::vec3 pos;
     glm::vec2 uv;
     VoxelVis vis;
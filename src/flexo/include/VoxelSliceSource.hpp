@@ -0,0 +1,27 @@
+#ifndef VOXEL_SLICE_SOURCE_H
+#define VOXEL_SLICE_SOURCE_H
+
+#include <glm/glm.hpp>
+
+/**
+ * Volume of unsigned char voxels that is accessed one Z-slice at a time
+ *
+ * A slice holds resolution.x * resolution.y voxels ordered by x, then y. Sources that keep the whole volume in memory
+ * return a pointer into it, while the others fill the scratch buffer, so the volume never has to be loaded at once.
+ */
+class VoxelSliceSource
+{
+public:
+    virtual ~VoxelSliceSource() = default;
+    virtual glm::ivec3 GetResolution() const = 0;
+    virtual glm::vec3 GetVoxelDims() const = 0;
+
+    /**
+     * @param z       Index of the slice
+     * @param scratch Buffer of one slice that the source may fill
+     * @return The voxels of the slice, valid until scratch is reused
+     */
+    virtual unsigned char const* GetSlice(int z, unsigned char* scratch) const = 0;
+};
+
+#endif
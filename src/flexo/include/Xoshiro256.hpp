@@ -0,0 +1,79 @@
+#ifndef XOSHIRO256_H
+#define XOSHIRO256_H
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * xoshiro256** pseudo-random number generator
+ *
+ * A small and fast 64-bit generator that satisfies UniformRandomBitGenerator, so it can drive the standard
+ * distributions. The 256-bit state is expanded from a single 64-bit seed with SplitMix64, so equal seeds always
+ * produce equal sequences on every platform.
+ */
+class Xoshiro256
+{
+public:
+    using result_type = std::uint64_t;
+
+    explicit Xoshiro256(std::uint64_t seed = 0)
+    {
+        Seed(seed);
+    }
+
+    void Seed(std::uint64_t seed)
+    {
+        for (auto& s : m_state) {
+            seed += 0x9e3779b97f4a7c15ull;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            s = z ^ (z >> 31);
+        }
+    }
+
+    result_type operator()()
+    {
+        std::uint64_t const result = Rotl(m_state[1] * 5, 7) * 9;
+        std::uint64_t const t = m_state[1] << 17;
+
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = Rotl(m_state[3], 45);
+
+        return result;
+    }
+
+    /**
+     * Uniform integer in [0, bound) by scaling the upper 32 bits, which avoids a division per number
+     *
+     * The bias is below bound / 2^32 and thus negligible for dataset sizes.
+     */
+    std::uint32_t Below(std::uint32_t bound)
+    {
+        return static_cast<std::uint32_t>(((operator()() >> 32) * bound) >> 32);
+    }
+
+    static constexpr result_type min()
+    {
+        return 0;
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+private:
+    static std::uint64_t Rotl(std::uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    std::uint64_t m_state[4];
+};
+
+#endif
@@ -10,10 +10,15 @@ class BaseImporter
 {
 protected:
     std::vector<unsigned char> m_buffer;
-    void Slurp(std::string const& filename);
+    std::string m_error;
+    bool Slurp(std::string const& filename);
 
 public:
+    /**
+     * @return The mesh in the file, or an empty mesh if it cannot be read, in which case GetError tells why
+     */
     virtual Mesh ReadFile(std::string const& filename) = 0;
+    std::string const& GetError() const;
 };
 
 #endif
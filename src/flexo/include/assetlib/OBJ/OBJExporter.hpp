@@ -0,0 +1,21 @@
+#ifndef OBJ_EXPORTER_H
+#define OBJ_EXPORTER_H
+
+#include <string>
+
+#include "gfx/EditableMesh.hpp"
+
+class OBJExporter
+{
+public:
+    /**
+     * Write the polygons of a mesh to a Wavefront OBJ file
+     *
+     * Texture coordinates are written and referenced by the faces when the mesh has one per position.
+     *
+     * @return Whether the whole file was written, the error is logged otherwise
+     */
+    bool WriteFile(std::string const& filename, EditableMesh const& mesh) const;
+};
+
+#endif
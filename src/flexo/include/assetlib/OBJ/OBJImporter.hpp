@@ -15,18 +15,37 @@ public:
 
 private:
     struct OBJModel {
+        /**
+         * Zero-based indices into the attribute arrays, -1 if the attribute is not given
+         */
         struct VertexRef {
             int v, vt, vn;
         };
 
-        using Face = std::vector<VertexRef>;
-
         std::vector<glm::vec3> positions;
+        std::vector<glm::vec2> textureCoords;
         std::vector<glm::vec3> normals;
-        std::vector<Face> faces;
+        // The vertex references of all faces one after another, and the number of vertices of each face
+        std::vector<VertexRef> refs;
+        std::vector<unsigned int> faceSizes;
+    };
+
+    /**
+     * Part of the file between two line breaks, parsed on its own
+     *
+     * Negative OBJ indices count back from the last attribute read so far, which depends on the chunks before. They
+     * are stored relative to the start of the chunk, and the references listed in relative are shifted when the
+     * chunks are merged.
+     */
+    struct Chunk {
+        OBJModel model;
+        std::vector<std::size_t> relative[3];
+        char const* error = nullptr;
     };
 
-    Mesh BuildMesh(OBJModel const& model) const;
+    static void ParseChunk(char const* first, char const* last, Chunk& chunk);
+    static OBJModel MergeChunks(std::vector<Chunk>& chunks);
+    Mesh BuildMesh(OBJModel const& model);
 };
 
 #endif
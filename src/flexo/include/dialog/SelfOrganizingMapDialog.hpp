@@ -1,6 +1,7 @@
 #ifndef SOM_PROJECT_DIALOG
 #define SOM_PROJECT_DIALOG
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -29,7 +30,10 @@ protected:
     void OnMapSelected(wxCommandEvent& event);
     void OnMaxIterationChanged(wxCommandEvent& event);
     void OnInitialRateChanged(wxCommandEvent& event);
+    void OnSeedChanged(wxCommandEvent& event);
     void OnInitialNeighborhoodChanged(wxCommandEvent& event);
+    void OnBMUSearchToggled(wxCommandEvent& event);
+    void OnTrainingModeToggled(wxCommandEvent& event);
     void SetupNeighborhoodRadiusSlider(float maxValue, float value);
 
     // SOM properties
@@ -38,9 +42,13 @@ protected:
     long int m_maxIterations;
     float m_leanringRate;
     float m_neighborhood;
+    BMUSearch m_bmuSearch;
+    TrainingMode m_trainingMode;
+    std::uint64_t m_seed;
 
     // Widgets
     wxSizer* m_topLayout;
+    wxTextCtrl* m_textIter;
     wxStaticText* m_textRadius;
     wxSlider* m_sliderRadius;
     FlexoProject& m_project;
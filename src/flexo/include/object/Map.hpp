@@ -1,10 +1,14 @@
 #ifndef MAP_H
 #define MAP_H
 
-#include "Node.hpp"
+#include "NodeStore.hpp"
+#include "TripleBuffer.hpp"
 #include "Vec.hpp"
 #include "object/Object.hpp"
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -30,20 +34,66 @@ struct Map : public Object {
     Map();
     virtual ~Map() = default;
     Vec<OutDim, int> size;
-    std::vector<Node<InDim, OutDim>> nodes;
+    NodeStore<InDim, OutDim> nodes;
     MapFlags flags;
     std::string textureName;
 
     template <typename... Params>
-    Node<InDim, OutDim>& At(Params&&... coordinates);
-    EditableMesh const& GetMesh() const;
+    typename NodeStore<InDim, OutDim>::Reference At(Params&&... coordinates);
     void GenerateDrawables(Graphics& gfx) override;
+
+    /**
+     * Bring the drawables up to date with the latest published weights
+     *
+     * The drawables are only created once. Afterwards new vertex positions are streamed into their existing buffers,
+     * and nothing is done at all if no weights have been published since the last call.
+     */
+    void UpdateDrawables(Graphics& gfx);
+
+    /**
+     * Move the nodes by the transform of the object and publish them
+     *
+     * A map that is being trained is refused, since its nodes belong to the SOM worker, and the transform stays on
+     * the object so that it can be applied once the training is over.
+     */
     void ApplyTransform() override;
 
-private:
+    /**
+     * Hand the nodes to a SOM worker, or take them back once it is done
+     *
+     * From then on only the worker changes and publishes the nodes, until it ends the training.
+     */
+    void SetBeingTrained(bool trained);
+    bool IsBeingTrained() const;
+
+    /**
+     * Publish a copy of the current node weights to the renderer
+     *
+     * The mesh is generated from the latest published weights, so the nodes can be trained on another thread
+     * without ever blocking the viewport. Only one thread may publish, which is the SOM worker while the map is
+     * being trained and the GUI thread otherwise.
+     */
+    void PublishWeights();
+
+    /**
+     * Rebuild the mesh of the map from the latest published weights without touching any drawables
+     */
     void GenerateMesh();
+
+private:
+    TripleBuffer<std::vector<Vec<InDim>>> m_snapshots;
+    std::atomic<bool> m_isBeingTrained;
 };
 
+/**
+ * Create a 3-to-2 map with its nodes laid out according to the initial state
+ *
+ * The map has no drawables yet, so it can be created without a graphics context. The seed only affects the random
+ * initial state.
+ */
+std::shared_ptr<Map<3, 2>> ConstructMap(int width, int height, MapFlags flags, MapInitState initState,
+                                        std::uint64_t seed = 0);
+
 #include "Map.cpp"
 
 #endif
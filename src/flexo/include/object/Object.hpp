@@ -73,6 +73,7 @@ public:
     ObjectType GetType() const;
     void SetVisible(bool visible);
     bool IsVisible() const;
+    EditableMesh const& GetMesh() const;
 
     virtual void GenerateDrawables(Graphics& gfx);
     virtual DrawList const& GetDrawList();
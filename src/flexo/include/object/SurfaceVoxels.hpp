@@ -1,6 +1,7 @@
 #ifndef VOXEL_SURFACE_H
 #define VOXEL_SURFACE_H
 
+#include <functional>
 #include <future>
 #include <vector>
 
@@ -9,26 +10,69 @@
 #include "Map.hpp"
 #include "Object.hpp"
 #include "Voxel.hpp"
+#include "VoxelDrawable.hpp"
 #include "gfx/Mesh.hpp"
+#include "gfx/bindable/VertexBuffer.hpp"
 
-class VolumetricModelData;
+class VoxelSliceSource;
+
+/**
+ * Called while the mesh is built with the percentage done, returns false to stop building it
+ */
+using MeshProgress = std::function<bool(float)>;
 
 class SurfaceVoxels : public Object
 {
 public:
-    SurfaceVoxels(VolumetricModelData const& modelData);
+    /**
+     * Collect the surface voxels of a volume without keeping the volume itself
+     */
+    SurfaceVoxels(VoxelSliceSource const& modelData);
+
+    /**
+     * Take surface voxels that were already extracted, e.g. by a ModelImport
+     *
+     * The mesh is left to GenerateMesh, so that the caller can report its progress or stop it.
+     */
+    SurfaceVoxels(std::vector<Voxel> voxels, glm::vec3 scale);
     virtual ~SurfaceVoxels() = default;
     std::vector<Voxel> const& Voxels() const;
     virtual std::vector<glm::vec3> GetPositions() const override;
     std::future<void> Parameterize(Map<3, 2> const& map, float& progress);
-    void GenerateMesh();
+
+    /**
+     * Build the mesh of the visible voxel faces
+     *
+     * With merging enabled, which is the default, coplanar neighbouring faces of voxels with equal texture
+     * coordinates are merged into rectangles. Faces of voxels whose texture coordinates differ stay separate, so the
+     * textured result looks the same either way.
+     *
+     * @return Whether the mesh was built, the previous mesh stays if it was stopped
+     */
+    bool GenerateMesh(MeshProgress const& progress = nullptr);
+    void SetMergeFaces(bool merge);
+
+    /**
+     * Upload the voxels as instances of a unit cube
+     *
+     * The voxel drawables replace the solid and textured mesh drawables, only the wireframe is still built from the
+     * mesh. As long as the number of voxels stays the same, e.g. after ApplyTransform or Parameterize, the instance
+     * buffer is updated in place instead of being recreated.
+     */
+    void GenerateDrawables(Graphics& gfx) override;
+    DrawList const& GetDrawList() override;
 
 private:
     void ApplyTransform() override;
     void GenEditableMesh();
+    void WriteInstances(VertexWriter const& writer) const;
 
+    bool m_mergeFaces;
     glm::vec3 m_scale;
     std::vector<Voxel> m_voxels;
+    std::shared_ptr<Bind::VertexBuffer> m_instances;
+    std::shared_ptr<VoxelDrawable> m_solidVoxels;
+    std::shared_ptr<VoxelDrawable> m_texturedVoxels;
 };
 
 #endif
@@ -0,0 +1,61 @@
+#include <cmath>
+
+#include "RandomRealNumber.hpp"
+#include "object/Map.hpp"
+
+constexpr auto PI = 3.14159265358979323846;
+
+std::shared_ptr<Map<3, 2>> ConstructMap(int width, int height, MapFlags flags, MapInitState initState,
+                                        std::uint64_t seed)
+{
+    auto map = std::make_shared<Map<3, 2>>();
+
+    float const w = static_cast<float>(width - 1);
+    float const h = static_cast<float>(height - 1);
+
+    switch (initState) {
+    default:
+    case MapInitState_Random: {
+        RandomRealNumber<float> rng(-5.0f, 5.0f, seed);
+
+        for (int j = 0; j < height; ++j) {
+            for (int i = 0; i < width; ++i) {
+                float const x = rng.scalar();
+                float const y = rng.scalar();
+                float const z = rng.scalar();
+                map->nodes.emplace_back(Vec3f { x, y, z },
+                                        Vec2f { static_cast<float>(i), static_cast<float>(j) }, Vec2f { i / w, j / h });
+            }
+        }
+    } break;
+    case MapInitState_Plane: {
+        float dx = 2.0f / static_cast<float>(width - 1);
+        float dy = 2.0f / static_cast<float>(height - 1);
+
+        for (int j = 0; j < height; ++j) {
+            for (int i = 0; i < width; ++i) {
+                map->nodes.emplace_back(Vec3f { -1.0f + i * dx, -1.0f + j * dy, 0.005f },
+                                        Vec2f { static_cast<float>(i), static_cast<float>(j) }, Vec2f { i / w, j / h });
+            }
+        }
+    } break;
+    case MapInitState_Cylinder: {
+        float dr = glm::radians(360.0f) / static_cast<float>(width - 1);
+        float dz = 2.0f * PI * 1.0f / static_cast<float>(height - 1);
+
+        for (int j = 0; j < height; ++j) {
+            for (int i = 0; i < width; ++i) {
+                auto rad = i * dr;
+                map->nodes.emplace_back(Vec3f { cos(rad), sin(rad), j * dz },
+                                        Vec2f { static_cast<float>(i), static_cast<float>(j) }, Vec2f { i / w, j / h });
+            }
+        }
+    } break;
+    }
+
+    map->size.x = width;
+    map->size.y = height;
+    map->flags = flags;
+
+    return map;
+}
@@ -19,12 +19,17 @@ void Object::GenerateDrawables(Graphics& gfx)
     if (!m_texture) {
         m_texture = Bind::TextureManager::Resolve(gfx, ResourcePath::GetImageFile("blank.png"), 0);
     }
-    auto m = m_mesh.GenerateMesh();
+    auto m = m_mesh.GenerateIndexedMesh();
     m_solid = std::make_shared<SolidDrawable>(gfx, m);
-    m_textured = std::make_shared<TexturedDrawable>(gfx, m_mesh.GenerateMesh(), m_texture);
+    m_textured = std::make_shared<TexturedDrawable>(gfx, m, m_texture);
     m_wire = std::make_shared<WireDrawable>(gfx, m_mesh.GenerateWireframe());
 }
 
+EditableMesh const& Object::GetMesh() const
+{
+    return m_mesh;
+}
+
 std::vector<glm::vec3> Object::GetPositions() const
 {
     return m_mesh.positions;
@@ -2,12 +2,15 @@
 #include <array>
 #include <cmath>
 #include <limits>
+#include <tuple>
 #include <utility>
 
 #include "Geometry.hpp"
+#include "ResourcePath.hpp"
+#include "SurfaceExtractor.hpp"
 #include "TransformStack.hpp"
+#include "TriangleBVH.hpp"
 #include "VecUtil.hpp"
-#include "VolumetricModelData.hpp"
 #include "log/Logger.h"
 #include "object/Map.hpp"
 #include "object/SurfaceVoxels.hpp"
@@ -15,69 +18,55 @@
 using VoxelFaceList = std::array<EditableMesh, 6>;
 static VoxelFaceList ConstructVoxelFaceList();
 static void AddFace(EditableMesh& mesh, EditableMesh const& voxelFace, glm::vec3 position, glm::vec3 scale);
+static bool AddMergedFaces(EditableMesh& mesh, VoxelFaceList const& faces, std::vector<Voxel> const& voxels,
+                           glm::vec3 scale, MeshProgress const& progress);
 
-SurfaceVoxels::SurfaceVoxels(VolumetricModelData const& modelData)
+SurfaceVoxels::SurfaceVoxels(VoxelSliceSource const& modelData)
     : Object(ObjectType_Model)
+    , m_mergeFaces(true)
 {
-    glm::ivec3 n = modelData.GetResolution();
     m_scale = modelData.GetVoxelDims();
 
-    const unsigned char* data = modelData.GetBuffer();
-
-    const unsigned char modelValue = 255;
-    const unsigned char air = 0;
-
-    glm::vec3 origin = -0.5f * glm::vec3 { (n.x - 1), (n.y - 1), (0 - 1) };
-
-    for (int i = 0; i < n.z; i++) {
-        for (int j = 0; j < n.y; j++) {
-            for (int k = 0; k < n.x; k++) {
-                int index = k + j * n.x + i * n.x * n.y;
-                VoxelVis vis = VoxelVis_None;
-                glm::vec3 offset { k, j, i };
-                if (data[index] == modelValue) {
-                    if ((k + 1 == n.x) || data[index + 1] == air) {
-                        vis |= VoxelVis_XPos;
-                    }
-                    if ((j + 1 == n.y) || (data[index + n.x] == air)) {
-                        vis |= VoxelVis_YPos;
-                    }
-                    if ((i + 1 == n.z) || (data[index + n.x * n.y] == air)) {
-                        vis |= VoxelVis_ZPos;
-                    }
-                    if ((k == 0) || (data[index - 1] == air)) {
-                        vis |= VoxelVis_XNeg;
-                    }
-                    if ((j == 0) || (data[index - n.x] == air)) {
-                        vis |= VoxelVis_YNeg;
-                    }
-                    if ((i == 0) || (data[index - n.x * n.y] == air)) {
-                        vis |= VoxelVis_ZNeg;
-                    }
-
-                    if (vis != VoxelVis_None) {
-                        m_voxels.emplace_back((origin + offset) * m_scale, glm::vec2(0.0f, 0.0f), vis);
-                    }
-                }
-            }
-        }
-    }
+    ExtractSurfaceVoxels(modelData, [this](Voxel const& vx) { m_voxels.push_back(vx); });
 
     GenerateMesh();
 }
 
+SurfaceVoxels::SurfaceVoxels(std::vector<Voxel> voxels, glm::vec3 scale)
+    : Object(ObjectType_Model)
+    , m_mergeFaces(true)
+    , m_scale(scale)
+    , m_voxels(std::move(voxels))
+{
+}
+
 std::vector<Voxel> const& SurfaceVoxels::Voxels() const
 {
     return m_voxels;
 }
 
-void SurfaceVoxels::GenerateMesh()
+bool SurfaceVoxels::GenerateMesh(MeshProgress const& progress)
 {
     static VoxelFaceList faces = ConstructVoxelFaceList();
 
     EditableMesh mesh;
 
-    for (auto const& vx : m_voxels) {
+    if (m_mergeFaces) {
+        if (!AddMergedFaces(mesh, faces, m_voxels, m_scale, progress)) {
+            return false;
+        }
+        m_mesh = std::move(mesh);
+        return true;
+    }
+
+    // Reported every this many voxels
+    std::size_t const progressInterval = 1 << 16;
+
+    for (std::size_t i = 0; i < m_voxels.size(); i++) {
+        Voxel const& vx = m_voxels[i];
+        if (progress && i % progressInterval == 0 && !progress(100.0f * i / m_voxels.size())) {
+            return false;
+        }
         if (vx.vis & VoxelVis_XPos) {
             AddFace(mesh, faces[0], vx.pos, m_scale);
             mesh.textureCoords.insert(mesh.textureCoords.end(), faces[0].positions.size(), vx.uv);
@@ -104,7 +93,13 @@ void SurfaceVoxels::GenerateMesh()
         }
     }
 
-    m_mesh = mesh;
+    m_mesh = std::move(mesh);
+    return true;
+}
+
+void SurfaceVoxels::SetMergeFaces(bool merge)
+{
+    m_mergeFaces = merge;
 }
 
 void SurfaceVoxels::ApplyTransform()
@@ -118,6 +113,67 @@ void SurfaceVoxels::ApplyTransform()
     GenerateMesh();
 }
 
+void SurfaceVoxels::GenerateDrawables(Graphics& gfx)
+{
+    if (!m_texture) {
+        m_texture = Bind::TextureManager::Resolve(gfx, ResourcePath::GetImageFile("blank.png"), 0);
+    }
+
+    if (m_instances && m_instances->GetCount() == m_voxels.size()) {
+        m_instances->Update(gfx, [this](VertexWriter const& writer) { WriteInstances(writer); });
+        m_solidVoxels->SetVoxelScale(m_scale);
+        m_texturedVoxels->SetVoxelScale(m_scale);
+        m_texturedVoxels->ChangeTexture(m_texture);
+    } else {
+        VertexArray instances(VoxelDrawable::GetInstanceLayout(), m_voxels.size());
+        WriteInstances(instances.GetWriter());
+
+        auto blank = Bind::TextureManager::Resolve(gfx, ResourcePath::GetImageFile("blank.png"), 0);
+        m_instances = std::make_shared<Bind::VertexBuffer>(gfx, instances);
+        m_solidVoxels = std::make_shared<VoxelDrawable>(gfx, m_instances, m_scale, blank);
+        m_texturedVoxels = std::make_shared<VoxelDrawable>(gfx, m_instances, m_scale, m_texture);
+    }
+
+    m_solid = nullptr;
+    m_textured = nullptr;
+    m_wire = std::make_shared<WireDrawable>(gfx, m_mesh.GenerateWireframe());
+}
+
+Object::DrawList const& SurfaceVoxels::GetDrawList()
+{
+    Object::GetDrawList();
+
+    std::shared_ptr<Drawable> voxels;
+    switch (m_flags) {
+    case ObjectViewFlag_Solid:
+    case ObjectViewFlag_SolidWithWireframe:
+        voxels = m_solidVoxels;
+        break;
+    case ObjectViewFlag_Textured:
+    case ObjectViewFlag_TexturedWithWireframe:
+        voxels = m_texturedVoxels;
+        break;
+    default:
+        break;
+    }
+
+    if (voxels) {
+        voxels->SetVisible(m_isVisible);
+        voxels->SetTransform(GenerateTransformStack().GenerateMatrix());
+        m_drawlist.insert(m_drawlist.begin(), voxels);
+    }
+
+    return m_drawlist;
+}
+
+void SurfaceVoxels::WriteInstances(VertexWriter const& writer) const
+{
+    writer.Generate<glm::vec3>("Position", [this](unsigned int i) { return m_voxels[i].pos; });
+    writer.Generate<glm::vec2>("TexCoord", [this](unsigned int i) { return m_voxels[i].uv; });
+    writer.Generate<unsigned int>("Visibility",
+                                  [this](unsigned int i) { return static_cast<unsigned int>(m_voxels[i].vis); });
+}
+
 std::vector<glm::vec3> SurfaceVoxels::GetPositions() const
 {
     std::vector<glm::vec3> pos(m_voxels.size());
@@ -140,29 +196,25 @@ std::future<void> SurfaceVoxels::Parameterize(Map<3, 2> const& map, float& progr
         std::launch::async,
         [this, &progress](EditableMesh const& mesh, std::vector<TriangularFace> const& faces) -> void {
             float const diff = 100.0f / static_cast<float>(m_voxels.size());
-            auto const& pos = mesh.positions;
-#pragma omp parallel for
-            for (auto& vx : m_voxels) {
+            TriangleBVH const bvh(mesh.positions, faces);
+            int const count = m_voxels.size();
+
+#pragma omp parallel for schedule(dynamic, 256)
+            for (int i = 0; i < count; i++) {
+                auto& vx = m_voxels[i];
                 glm::vec3 closest;
-                TriangularFace target;
-                float minDist = std::numeric_limits<float>::max();
-
-#pragma omp parallel for reduction(+ : progress)
-                for (auto const& f : faces) {
-                    glm::vec3 point = geom::Triangle(pos[f.x], pos[f.y], pos[f.z]).ClosestPointTo(vx.pos);
-                    float dist = geom::SquaredDistance(vx.pos, point);
-                    if (minDist > dist) {
-                        minDist = dist;
-                        closest = point;
-                        target = f;
-                    }
+                unsigned int const index = bvh.FindClosest(vx.pos, closest);
+
+                if (index < faces.size()) {
+                    auto const& target = faces[index];
+                    auto const& pos = mesh.positions;
+                    auto weights
+                        = geom::Triangle(pos[target.x], pos[target.y], pos[target.z]).BarycentricCoordinates(closest);
+                    vx.uv = mesh.textureCoords[target.x] * weights.x + mesh.textureCoords[target.y] * weights.y
+                        + mesh.textureCoords[target.z] * weights.z;
                 }
 
-                auto weights
-                    = geom::Triangle(pos[target.x], pos[target.y], pos[target.z]).BarycentricCoordinates(closest);
-                vx.uv = mesh.textureCoords[target.x] * weights.x + mesh.textureCoords[target.y] * weights.y
-                    + mesh.textureCoords[target.z] * weights.z;
-
+#pragma omp atomic
                 progress += diff;
             }
         },
@@ -232,10 +284,124 @@ void AddFace(EditableMesh& mesh, EditableMesh const& voxelFace, glm::vec3 positi
         mesh.positions.emplace_back(pos * scale + position);
     }
 
-    for (auto face : voxelFace.faces) {
-        for (auto& idx : face) {
-            idx += offset;
+    mesh.faces.Append(voxelFace.faces, offset);
+}
+
+/**
+ * Merge the visible faces into rectangles
+ *
+ * The faces of each direction are sorted by layer, row and column. Consecutive faces in a row with the same texture
+ * coordinates form runs, and a run extends the rectangle of the previous row if it covers the same columns with the
+ * same texture coordinates. Every corner of a rectangle is placed like the corner of the face of its corner voxel, so
+ * the outline matches the separate faces exactly.
+ *
+ * The progress is reported after every layer.
+ */
+bool AddMergedFaces(EditableMesh& mesh, VoxelFaceList const& faces, std::vector<Voxel> const& voxels, glm::vec3 scale,
+                    MeshProgress const& progress)
+{
+    struct FaceRef {
+        int layer;
+        int v;
+        int u;
+        unsigned int voxel;
+    };
+
+    struct Rect {
+        int u0, u1;
+        int v1;
+        unsigned int corners[2][2]; // Voxels at [u1?][v1?]
+    };
+
+    for (int d = 0; d < 6; d++) {
+        int const axis = d / 2;
+        int const uAxis = (axis + 1) % 3;
+        int const vAxis = (axis + 2) % 3;
+        VoxelVis const flag = static_cast<VoxelVis>(1 << d);
+        EditableMesh const& face = faces[d];
+
+        std::vector<FaceRef> refs;
+        for (unsigned int i = 0; i < voxels.size(); i++) {
+            if (voxels[i].vis & flag) {
+                glm::ivec3 const& c = voxels[i].coord;
+                refs.push_back(FaceRef { c[axis], c[vAxis], c[uAxis], i });
+            }
+        }
+        std::sort(refs.begin(), refs.end(), [](FaceRef const& a, FaceRef const& b) {
+            return std::tie(a.layer, a.v, a.u) < std::tie(b.layer, b.v, b.u);
+        });
+
+        auto const addRect = [&](Rect const& rect) {
+            unsigned int const offset = mesh.positions.size();
+            glm::vec2 const uv = voxels[rect.corners[0][0]].uv;
+            for (auto const& pos : face.positions) {
+                Voxel const& corner = voxels[rect.corners[pos[uAxis] > 0.0f][pos[vAxis] > 0.0f]];
+                mesh.positions.emplace_back(pos * scale + corner.pos);
+                mesh.textureCoords.push_back(uv);
+            }
+            mesh.faces.Append(face.faces, offset);
+        };
+
+        std::vector<Rect> open;
+        std::vector<Rect> next;
+        std::size_t first = 0;
+
+        while (first < refs.size()) {
+            // A row of faces on one layer
+            std::size_t last = first + 1;
+            while (last < refs.size() && refs[last].layer == refs[first].layer && refs[last].v == refs[first].v) {
+                last++;
+            }
+
+            int const layer = refs[first].layer;
+            int const v = refs[first].v;
+            std::size_t p = 0;
+            next.clear();
+
+            for (std::size_t i = first; i < last;) {
+                glm::vec2 const uv = voxels[refs[i].voxel].uv;
+                std::size_t j = i + 1;
+                while (j < last && refs[j].u == refs[j - 1].u + 1 && voxels[refs[j].voxel].uv == uv) {
+                    j++;
+                }
+
+                Rect run { refs[i].u, refs[j - 1].u, v, { { refs[i].voxel, refs[i].voxel },
+                                                          { refs[j - 1].voxel, refs[j - 1].voxel } } };
+
+                while (p < open.size() && open[p].u0 < run.u0) {
+                    addRect(open[p++]);
+                }
+                if (p < open.size() && open[p].u0 == run.u0 && open[p].u1 == run.u1 && open[p].v1 == v - 1
+                    && voxels[open[p].corners[0][0]].uv == uv) {
+                    run.corners[0][0] = open[p].corners[0][0];
+                    run.corners[1][0] = open[p].corners[1][0];
+                    p++;
+                }
+                next.push_back(run);
+                i = j;
+            }
+
+            while (p < open.size()) {
+                addRect(open[p++]);
+            }
+            std::swap(open, next);
+
+            // Nothing continues across layers.
+            if (last == refs.size() || refs[last].layer != layer) {
+                for (auto const& rect : open) {
+                    addRect(rect);
+                }
+                open.clear();
+
+                float const done = d + static_cast<float>(last) / refs.size();
+                if (progress && !progress(100.0f * done / 6.0f)) {
+                    return false;
+                }
+            }
+
+            first = last;
         }
-        mesh.faces.push_back(std::move(face));
     }
+
+    return true;
 }
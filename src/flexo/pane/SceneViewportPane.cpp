@@ -14,6 +14,7 @@
 #include "dialog/ViewportSettingsDialog.hpp"
 #include "gfx/Camera.hpp"
 #include "gfx/Renderer.hpp"
+#include "gfx/bindable/TextureManager.hpp"
 #include "log/Logger.h"
 #include "pane/SceneViewportPane.hpp"
 
@@ -114,12 +115,14 @@ void SceneViewportPane::OnPaint(wxPaintEvent&)
     SetCurrent(*m_context);
 
     auto& gfx = *m_gfx;
+    Bind::TextureManager::Update(gfx);
+
     auto bg = glm::vec4(m_settings.background, 1.0f);
     gfx.ClearRenderTargetView(m_rtv.Get(), &bg.x);
     gfx.ClearDepthStencilView(m_dsv.Get(), GLWRClearFlag_Depth);
 
     if (auto map = m_currMap.lock()) {
-        map->GenerateDrawables(gfx);
+        map->UpdateDrawables(gfx);
     }
 
     auto& renderer = *m_renderer;
@@ -127,7 +127,9 @@ void SelfOrganizingMapPane::OnConfigure(wxCommandEvent&)
         *m_textRate << m_somModel->learningRate;
         *m_textRadius << m_somModel->neighborhood;
 
-        m_som = std::make_unique<SelfOrganizingMap>(*m_somModel, m_project);
+        // The previous worker has to give its map back before the new one takes a map, which may be the same.
+        m_som.reset();
+        m_som = std::make_unique<SelfOrganizingMap>(*m_somModel);
 
         SceneViewportPane::Get(m_project).SetCurrentMap(m_somModel->map);
 
@@ -35,7 +35,12 @@ out vec4 outColor;
 
 void main()
 {
-  vec3 norm = normalize(inData.normal);
+  // Without a normal attribute the normal stays zero, and the triangle is shaded flat from its derivatives instead.
+  vec3 norm = inData.normal;
+  if (dot(norm, norm) == 0.0) {
+    norm = cross(dFdx(inData.position), dFdy(inData.position));
+  }
+  norm = normalize(norm);
   vec3 lightDir = normalize(light.position - inData.position);
 
   float diffuseCoef = dot(norm, lightDir);
@@ -0,0 +1,65 @@
+#version 430
+
+layout(std140, binding = 0) uniform Transform {
+    mat4 model;
+    mat4 viewProj;
+} mx;
+
+layout(std140, binding = 4) uniform Voxel {
+    vec3 scale;
+} voxel;
+
+in vec3 instancePosition;
+in vec2 instanceTextureCoord;
+in uint instanceVisibility;
+
+out VertOut {
+    vec3 position;
+    vec3 normal;
+    vec2 textureCoord;
+} outData;
+
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+// Faces in the order of the VoxelVis bits: +X, -X, +Y, -Y, +Z, -Z
+const vec3 normals[6] = vec3[](
+    vec3(+1.0, 0.0, 0.0), vec3(-1.0, 0.0, 0.0),
+    vec3(0.0, +1.0, 0.0), vec3(0.0, -1.0, 0.0),
+    vec3(0.0, 0.0, +1.0), vec3(0.0, 0.0, -1.0)
+);
+
+// Two triangles per face of the unit cube
+const vec3 corners[36] = vec3[](
+    vec3(+0.5, -0.5, -0.5), vec3(+0.5, +0.5, -0.5), vec3(+0.5, +0.5, +0.5),
+    vec3(+0.5, -0.5, -0.5), vec3(+0.5, +0.5, +0.5), vec3(+0.5, -0.5, +0.5),
+    vec3(-0.5, -0.5, +0.5), vec3(-0.5, +0.5, +0.5), vec3(-0.5, +0.5, -0.5),
+    vec3(-0.5, -0.5, +0.5), vec3(-0.5, +0.5, -0.5), vec3(-0.5, -0.5, -0.5),
+    vec3(-0.5, +0.5, -0.5), vec3(-0.5, +0.5, +0.5), vec3(+0.5, +0.5, +0.5),
+    vec3(-0.5, +0.5, -0.5), vec3(+0.5, +0.5, +0.5), vec3(+0.5, +0.5, -0.5),
+    vec3(+0.5, -0.5, -0.5), vec3(+0.5, -0.5, +0.5), vec3(-0.5, -0.5, +0.5),
+    vec3(+0.5, -0.5, -0.5), vec3(-0.5, -0.5, +0.5), vec3(-0.5, -0.5, -0.5),
+    vec3(-0.5, -0.5, +0.5), vec3(+0.5, -0.5, +0.5), vec3(+0.5, +0.5, +0.5),
+    vec3(-0.5, -0.5, +0.5), vec3(+0.5, +0.5, +0.5), vec3(-0.5, +0.5, +0.5),
+    vec3(-0.5, +0.5, -0.5), vec3(+0.5, +0.5, -0.5), vec3(+0.5, -0.5, -0.5),
+    vec3(-0.5, +0.5, -0.5), vec3(+0.5, -0.5, -0.5), vec3(-0.5, -0.5, -0.5)
+);
+
+void main()
+{
+    int face = gl_VertexID / 6;
+    vec3 position = instancePosition + corners[gl_VertexID] * voxel.scale;
+
+    outData.position = vec3(mx.model * vec4(position, 1.0));
+    outData.normal = mat3(transpose(inverse(mx.model))) * normals[face];
+    outData.textureCoord = instanceTextureCoord;
+
+    // The vertices of a hidden face all land on the same point outside of the clip volume, so it is never rasterized.
+    if ((instanceVisibility & (1u << face)) == 0u) {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+    } else {
+        gl_Position = mx.viewProj * mx.model * vec4(position, 1.0);
+    }
+}
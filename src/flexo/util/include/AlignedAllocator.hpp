@@ -0,0 +1,49 @@
+#ifndef ALIGNED_ALLOCATOR_H
+#define ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+/**
+ * Allocator for containers whose storage is read by aligned SIMD loads
+ */
+template <typename T, std::size_t Alignment>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(AlignedAllocator<U, Alignment> const&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept
+    {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+};
+
+template <typename T, typename U, std::size_t Alignment>
+bool operator==(AlignedAllocator<T, Alignment> const&, AlignedAllocator<U, Alignment> const&)
+{
+    return true;
+}
+
+template <typename T, typename U, std::size_t Alignment>
+bool operator!=(AlignedAllocator<T, Alignment> const&, AlignedAllocator<U, Alignment> const&)
+{
+    return false;
+}
+
+#endif
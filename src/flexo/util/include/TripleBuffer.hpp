@@ -0,0 +1,77 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+
+/**
+ * Lock-free triple buffer for handing data from one producer thread to one consumer thread
+ *
+ * The producer fills Back() and publishes it by atomically exchanging it with the shared middle slot. The consumer
+ * takes the latest published slot in the same way. Neither side ever waits for the other, and the consumer always
+ * sees a complete buffer. Buffers that were published but never consumed are simply overwritten.
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer()
+        : m_buffers()
+        , m_middle(1)
+        , m_back(0)
+        , m_front(2)
+    {
+    }
+
+    TripleBuffer(TripleBuffer const&) = delete;
+    TripleBuffer& operator=(TripleBuffer const&) = delete;
+
+    /**
+     * Buffer owned by the producer
+     */
+    T& Back()
+    {
+        return m_buffers[m_back];
+    }
+
+    /**
+     * Make the back buffer the latest published one. The producer gets a recycled buffer in exchange.
+     */
+    void Publish()
+    {
+        m_back = m_middle.exchange(m_back | FreshFlag, std::memory_order_acq_rel) & IndexMask;
+    }
+
+    /**
+     * Take the latest published buffer if the producer has published since the last call.
+     *
+     * @return Whether Front() changed
+     */
+    bool Consume()
+    {
+        if (!(m_middle.load(std::memory_order_acquire) & FreshFlag)) {
+            return false;
+        }
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & IndexMask;
+        return true;
+    }
+
+    /**
+     * Buffer owned by the consumer
+     */
+    T const& Front() const
+    {
+        return m_buffers[m_front];
+    }
+
+private:
+    static constexpr unsigned int IndexMask = 0x3;
+    static constexpr unsigned int FreshFlag = 0x4;
+
+    std::array<T, 3> m_buffers;
+    std::atomic<unsigned int> m_middle;
+    unsigned int m_back;
+    unsigned int m_front;
+};
+
+#endif